@@ -661,6 +661,35 @@ template simulationFile_alg(SimCode simCode)
   end match
 end simulationFile_alg;
 
+template simulationFile_eqs(SimCode simCode, list<SimEqSystem> eqs)
+"Equation functions of one of the files given by SimCodeUtil.equationFiles"
+::=
+  let modelNamePrefixStr = modelNamePrefix(simCode)
+  <<
+  /* Equations */
+  <%simulationFileHeader(simCode)%>
+
+  #ifdef __cplusplus
+  extern "C" {
+  #endif
+
+  <%eqs |> eq => equation_impl(-1, eq, contextSimulationDiscrete, modelNamePrefixStr); separator="\n"%>
+
+  #ifdef __cplusplus
+  }
+  #endif<%\n%>
+  >>
+  /* adrpo: leave a newline at the end of file to get rid of the warning */
+end simulationFile_eqs;
+
+template equationFileNames(SimCode simCode)
+"Lists the files the equation functions are distributed over, for the makefiles."
+::=
+  match simCode
+  case SIMCODE(__) then
+    SimCodeUtil.equationFiles(allEquations) |> eqs hasindex i fromindex 1 => ' <%fileNamePrefix%>_17eqs<%i%>.c'
+end equationFileNames;
+
 template simulationFile_asr(SimCode simCode)
 "Asserts"
 ::=
@@ -958,7 +987,7 @@ template simulationFile(SimCode simCode, String guid, Boolean isModelExchangeFMU
 
     <%functionSymEuler(modelInfo, modelNamePrefixStr)%>
 
-    <%functionODE(odeEquations,(match simulationSettingsOpt case SOME(settings as SIMULATION_SETTINGS(__)) then settings.method else ""), hpcomData.schedules, modelNamePrefixStr)%>
+    <%functionODE(odeEquations,(match simulationSettingsOpt case SOME(settings as SIMULATION_SETTINGS(__)) then settings.method else ""), hpcomData.schedules, partitionData, modelInfo, modelNamePrefixStr)%>
 
     #ifdef FMU_EXPERIMENTAL
     <% if Flags.isSet(Flags.FMU_EXPERIMENTAL) then functionODEPartial(odeEquations,(match simulationSettingsOpt case SOME(settings as SIMULATION_SETTINGS(__)) then settings.method else ""), hpcomData.schedules, modelNamePrefixStr, modelInfo)%>
@@ -1062,7 +1091,7 @@ template simulationFile(SimCode simCode, String guid, Boolean isModelExchangeFMU
     <%\n%>
     };
 
-    <%functionInitializeDataStruc(modelInfo, fileNamePrefix, guid, delayedExps, modelNamePrefixStr, isModelExchangeFMU)%>
+    <%functionInitializeDataStruc(modelInfo, fileNamePrefix, guid, delayedExps, partitionData, modelNamePrefixStr, isModelExchangeFMU)%>
 
     #ifdef __cplusplus
     }
@@ -1251,7 +1280,7 @@ template populateModelInfo(ModelInfo modelInfo, String fileNamePrefix, String gu
   end match
 end populateModelInfo;
 
-template functionInitializeDataStruc(ModelInfo modelInfo, String fileNamePrefix, String guid, DelayedExpression delayed, String modelNamePrefix, Boolean isModelExchangeFMU)
+template functionInitializeDataStruc(ModelInfo modelInfo, String fileNamePrefix, String guid, DelayedExpression delayed, PartitionData partitionData, String modelNamePrefix, Boolean isModelExchangeFMU)
   "Generates function in simulation file."
 ::=
   <<
@@ -1260,10 +1289,44 @@ template functionInitializeDataStruc(ModelInfo modelInfo, String fileNamePrefix,
     assertStreamPrint(threadData,0!=data, "Error while initialize Data");
     data->callback = &<%symbolName(modelNamePrefix,"callback")%>;
     <%populateModelInfo(modelInfo, fileNamePrefix, guid, delayed, isModelExchangeFMU)%>
+    <%populateActivators(modelInfo, partitionData)%>
   }
   >>
 end functionInitializeDataStruc;
 
+template isMultiratePartitioned(ModelInfo modelInfo, PartitionData partitionData)
+  "Returns true if the ode equations are generated per multi-rate partition.
+   The solver needs an activator for every state."
+::=
+  match modelInfo
+  case MODELINFO(varInfo=VARINFO(__)) then
+    match partitionData
+    case PARTITIONDATA(__) then
+      if Flags.isSet(Flags.MULTIRATE_PARTITION) then
+        if intGt(numPartitions, 0) then
+          if intEq(listLength(stateToActivators), varInfo.numStateVars) then "true"
+end isMultiratePartitioned;
+
+template populateActivators(ModelInfo modelInfo, PartitionData partitionData)
+  "Generates the activator of the multi-rate partitions of each state."
+::=
+  match partitionData
+  case PARTITIONDATA(__) then
+    if isMultiratePartitioned(modelInfo, partitionData) then
+      <<
+      {
+        static const int stateActivator[<%listLength(stateToActivators)%>] = {<%stateToActivators |> act => intSub(act, 1) ;separator=", "%>};
+        data->modelData->nActivators = <%listLength(stateToActivators)%>;
+        data->modelData->stateActivator = stateActivator;
+      }
+      >>
+    else
+      <<
+      data->modelData->nActivators = 0;
+      data->modelData->stateActivator = NULL;
+      >>
+end populateActivators;
+
 template functionSimProfDef(SimEqSystem eq, Integer value, Text &reverseProf)
   "Generates function in simulation file."
 ::=
@@ -2960,12 +3023,7 @@ template functionXXX_systems_HPCOM(list<list<SimEqSystem>> eqs, String name, Tex
        let &varDecls += 'int id;<%\n%>'
        let &loop +=
          if Flags.isSet(Flags.PARMODAUTO) then /* Text for the loop body that calls the equations */
-         <<
-         #pragma omp parallel for private(id) schedule(<%match noProc() case 0 then "dynamic" else "static"%>)
-         for(id=0; id<<%nFuncs%>; id++) {
-           function<%name%>_systems[id](data, threadData);
-         }
-         >>
+           functionXXX_systems_parallelLoop(name, nFuncs, &varDecls)
          else
          <<
          for(id=0; id<<%nFuncs%>; id++) {
@@ -3566,13 +3624,14 @@ template functionXXX_systems(list<list<SimEqSystem>> eqs, String name, Text &loo
     funcs //just the one function
   case nFuncs then //2 and more
     let funcNames = eqs |> e hasindex i0 fromindex 0 => 'function<%name%>_system<%i0%>' ; separator=",\n"
-    let head = if Flags.isSet(Flags.PARMODAUTO) then '#pragma omp parallel for private(id) schedule(<%match noProc() case 0 then "dynamic" else "static"%>)'
     let &varDecls += 'int id;<%\n%>'
 
     let &loop +=
       /* Text for the loop body that calls the equations */
+      if Flags.isSet(Flags.PARMODAUTO) then
+        functionXXX_systems_parallelLoop(name, nFuncs, &varDecls)
+      else
       <<
-      <%head%>
       for(id=0; id<<%nFuncs%>; id++) {
         function<%name%>_systems[id](data, threadData);
       }
@@ -3587,6 +3646,30 @@ template functionXXX_systems(list<list<SimEqSystem>> eqs, String name, Text &loo
 end functionXXX_systems;
 
 
+template functionXXX_systems_parallelLoop(String name, Integer nFuncs, Text &varDecls)
+ "Generates the loop that evaluates independent equation systems in parallel.
+  Every thread runs on its own threadData, so the algebraic systems solved by
+  different threads do not share solver state. An error in one of the threads
+  is re-thrown on the calling thread after all threads have finished."
+::=
+  let &varDecls += 'int fail=0;<%\n%>'
+  <<
+  #pragma omp parallel
+  {
+    MMC_TRY_TOP()
+    #pragma omp for private(id) schedule(<%match noProc() case 0 then "dynamic" else "static"%>) nowait
+    for(id=0; id<<%nFuncs%>; id++) {
+      function<%name%>_systems[id](data, threadData);
+    }
+    MMC_CATCH_TOP(fail=1)
+  }
+  if (fail) {
+    throwStreamPrint(threadData, "Failed to evaluate the independent <%name%> systems in parallel.");
+  }
+  >>
+end functionXXX_systems_parallelLoop;
+
+
 template equationNamesArrayFormat(SimEqSystem eq, Context context, String name, Integer arrayIndex, Text &arrayEqs, Text &forwardEqs, String modelNamePrefixStr)
  "Generates an equation.
   This template should not be used for a SES_RESIDUAL.
@@ -3652,7 +3735,7 @@ match eqlstlst
   error(sourceInfo(), 'TODO more than ODE list in <%name%> systems')
 end functionXXX_systems_arrayFormat;
 
-template functionODE(list<list<SimEqSystem>> derivativEquations, Text method, Option<tuple<Schedule,Schedule,Schedule>> hpcOmSchedules, String modelNamePrefix)
+template functionODE(list<list<SimEqSystem>> derivativEquations, Text method, Option<tuple<Schedule,Schedule,Schedule>> hpcOmSchedules, PartitionData partitionData, ModelInfo modelInfo, String modelNamePrefix)
  "Generates function in simulation file."
 ::=
   let () = System.tmpTickReset(0)
@@ -3660,7 +3743,9 @@ template functionODE(list<list<SimEqSystem>> derivativEquations, Text method, Op
   let &varDecls2 = buffer ""
   let &varDecls = buffer ""
   let &fncalls = buffer ""
-  let systems = if Flags.isSet(Flags.HPCOM) then
+  let systems = if isMultiratePartitioned(modelInfo, partitionData) then
+                    (functionODE_partitions(derivativEquations, partitionData, &fncalls, modelNamePrefix))
+                else if Flags.isSet(Flags.HPCOM) then
                     (functionXXX_systems_HPCOM(derivativEquations, "ODE", &fncalls, &varDecls, hpcOmSchedules, modelNamePrefix))
                 else if Flags.isSet(Flags.PARMODAUTO) then
                     (functionXXX_systems_arrayFormat(derivativEquations, "ODE", &fncalls, &nrfuncs, &varDecls, modelNamePrefix))
@@ -3693,6 +3778,42 @@ template functionODE(list<list<SimEqSystem>> derivativEquations, Text method, Op
   >>
 end functionODE;
 
+template functionODE_partitions(list<list<SimEqSystem>> derivativEquations, PartitionData partitionData, Text &loop, String modelNamePrefixStr)
+  "Generates the ode equations grouped by multi-rate partitions. A partition is
+   evaluated if one of its activators is set, see the multirate solver."
+::=
+  match partitionData
+  case PARTITIONDATA(__) then
+    let odeEquations = List.flatten(derivativEquations)
+    let forwardEqs = odeEquations |> eq => equationForward_(eq,contextSimulationNonDiscrete,modelNamePrefixStr); separator="\n"
+    let parts = List.intRange(numPartitions) |> partIdx =>
+      let condition = listGet(activatorsForPartitions, partIdx) |> act => 'activators[<%intSub(act, 1)%>]' ;separator=" || "
+      let odeEqs = SimCodeUtil.getSimEqSystemsByIndexLst(listGet(partitions, partIdx), odeEquations) |> eq =>
+        equationNames_(eq,contextSimulationNonDiscrete,modelNamePrefixStr) ;separator="\n"
+      <<
+      /* partition <%partIdx%> */
+      if(<%condition%>) {
+        <%odeEqs%>
+      }
+      >> ;separator="\n"
+    let &loop +=
+        <<
+        functionODE_partitions(data, threadData);
+        >>
+    <<
+
+    /* forwarded equations */
+    <%forwardEqs%>
+
+    static void functionODE_partitions(DATA *data, threadData_t *threadData)
+    {
+      const modelica_boolean *activators = data->simulationInfo->activators;
+
+      <%parts%>
+    }
+    >>
+end functionODE_partitions;
+
 template functionAlgebraic(list<list<SimEqSystem>> algebraicEquations, String modelNamePrefix)
   "Generates function in simulation file."
 ::=
@@ -3881,6 +4002,12 @@ template functionDAE(list<SimEqSystem> allEquationsPlusWhen, String modelNamePre
                 (allEquationsPlusWhen |> eq hasindex i0 =>
                     equation_arrayFormat(eq, "DAE", contextSimulationDiscrete, i0, &eqArray, &eqfuncs, modelNamePrefix)
                     ;separator="\n")
+              else if intGt(SimCodeUtil.equationFileCount(allEquationsPlusWhen), 1) then
+                /* the equation functions are in the _eqs*.c files, see simulationFile_eqs */
+                (allEquationsPlusWhen |> eq =>
+                    let &eqfuncs += equationForward_(eq, contextSimulationDiscrete, modelNamePrefix)
+                    equation_call(eq, modelNamePrefix)
+                    ;separator="\n")
               else
                 (allEquationsPlusWhen |> eq hasindex i0 =>
                     let &eqfuncs += equation_impl(-1, eq, contextSimulationDiscrete, modelNamePrefix)
@@ -4863,24 +4990,23 @@ case SES_SIMPLE_ASSIGN(__) then
 end equationSimpleAssign;
 
 template equationForLoop(SimEqSystem eq, Context context, Text &varDecls, Text &auxFunction)
- "Generates an equation that is a for-loop."
+ "Generates an equation that is a for-loop over the elements of arrays."
 ::=
 match eq
-case SES_FOR_LOOP(__) then
+case SES_FOR_LOOP(iter=CREF(componentRef=iterCref)) then
   let &preExp = buffer ""
+  let iterVar = contextCref(iterCref, context, &auxFunction)
+  let &varDecls += 'modelica_integer <%iterVar%>; /* the iterator */<%\n%>'
   let expPart = daeExp(exp, context, &preExp, &varDecls, &auxFunction)
-  let crefPart = daeExp(crefExp(cref), context, &preExp, &varDecls, &auxFunction)
-  //let bodyStr = daeExpIteratedCref(body)
+  let crefPart = daeExpCrefLhs(crefExp(cref), context, &preExp, &varDecls, &auxFunction, false)
   let start = dumpExp(startIt,"\"")
   let stop = dumpExp(endIt,"\"")
-  let iterVar = daeExp(iter, context, &preExp, &varDecls, &auxFunction)
   <<
   <%modelicaLine(eqInfo(eq))%>
-  modelica_integer  $P<%dumpExp(iter,"\"")%> = 0; // the iterator
-  // the for-equation
-  for($P<%dumpExp(iter,"\"")%> = <%start%>; $P<%dumpExp(iter,"\"")%> != <%stop%>+1; $P<%dumpExp(iter,"\"")%>++)
+  for(<%iterVar%> = <%start%>; <%iterVar%> <= <%stop%>; <%iterVar%>++)
   {
-    <%crefPart%> += <%expPart%>;
+    <%preExp%>
+    <%crefPart%> = <%expPart%>;
   }
   <%endModelicaLine()%>
   >>
@@ -5430,7 +5556,7 @@ case SIMCODE(modelInfo=MODELINFO(__), makefileParams=MAKEFILE_PARAMS(__), simula
   CFILES=<%fileNamePrefix%>_functions.c <%fileNamePrefix%>_records.c \
   <%fileNamePrefix%>_01exo.c <%fileNamePrefix%>_02nls.c <%fileNamePrefix%>_03lsy.c <%fileNamePrefix%>_04set.c <%fileNamePrefix%>_05evt.c <%fileNamePrefix%>_06inz.c <%fileNamePrefix%>_07dly.c \
   <%fileNamePrefix%>_08bnd.c <%fileNamePrefix%>_09alg.c <%fileNamePrefix%>_10asr.c <%fileNamePrefix%>_11mix.c <%fileNamePrefix%>_12jac.c <%fileNamePrefix%>_13opt.c <%fileNamePrefix%>_14lnz.c \
-  <%fileNamePrefix%>_15syn.c <%fileNamePrefix%>_16dae.c
+  <%fileNamePrefix%>_15syn.c <%fileNamePrefix%>_16dae.c<%equationFileNames(simCode)%>
   OFILES=$(CFILES:.c=.obj)
   GENERATEDFILES=$(MAINFILE) $(FILEPREFIX)_functions.h $(FILEPREFIX).makefile $(CFILES)
 
@@ -5481,7 +5607,7 @@ case SIMCODE(modelInfo=MODELINFO(__), makefileParams=MAKEFILE_PARAMS(__), simula
   CFILES=<%fileNamePrefix%>_functions.c <%fileNamePrefix%>_records.c \
   <%fileNamePrefix%>_01exo.c <%fileNamePrefix%>_02nls.c <%fileNamePrefix%>_03lsy.c <%fileNamePrefix%>_04set.c <%fileNamePrefix%>_05evt.c <%fileNamePrefix%>_06inz.c <%fileNamePrefix%>_07dly.c \
   <%fileNamePrefix%>_08bnd.c <%fileNamePrefix%>_09alg.c <%fileNamePrefix%>_10asr.c <%fileNamePrefix%>_11mix.c <%fileNamePrefix%>_12jac.c <%fileNamePrefix%>_13opt.c <%fileNamePrefix%>_14lnz.c \
-  <%fileNamePrefix%>_15syn.c <%fileNamePrefix%>_16dae.c
+  <%fileNamePrefix%>_15syn.c <%fileNamePrefix%>_16dae.c<%equationFileNames(simCode)%>
   OFILES=$(CFILES:.c=.o)
   GENERATEDFILES=$(MAINFILE) <%fileNamePrefix%>.makefile <%fileNamePrefix%>_literals.h <%fileNamePrefix%>_functions.h $(CFILES)
 
@@ -5691,13 +5817,14 @@ template functionXXX_systemsPartial(list<list<SimEqSystem>> eqs, String name, Te
     funcs //just the one function
   case nFuncs then //2 and more
     let funcNames = eqs |> e hasindex i0 fromindex 0 => 'function<%name%>_system<%i0%>' ; separator=",\n"
-    let head = if Flags.isSet(Flags.PARMODAUTO) then '#pragma omp parallel for private(id) schedule(<%match noProc() case 0 then "dynamic" else "static"%>)'
     let &varDecls += 'int id;<%\n%>'
 
     let &loop +=
       /* Text for the loop body that calls the equations */
+      if Flags.isSet(Flags.PARMODAUTO) then
+        functionXXX_systems_parallelLoop(name, nFuncs, &varDecls)
+      else
       <<
-      <%head%>
       for(id=0; id<<%nFuncs%>; id++) {
         function<%name%>_systems[id](data, threadData);
       }
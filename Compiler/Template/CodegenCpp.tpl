@@ -401,6 +401,7 @@ case SIMCODE(modelInfo=MODELINFO(vars = vars as SIMVARS(__))) then
     virtual const matrix_t& getJacobian(unsigned int index) ;
     virtual const sparsematrix_t& getSparseJacobian();
     virtual const sparsematrix_t& getSparseJacobian(unsigned int index);
+    virtual bool isJacobianSparse();
 
 
     virtual  const matrix_t& getStateSetJacobian(unsigned int index);
@@ -1122,6 +1123,11 @@ case SIMCODE(modelInfo = MODELINFO(__)) then
      <%getSparseMatrix%>
    }
 
+   bool <%classname%>Mixed::isJacobianSparse()
+   {
+     return <%if stringEq(type, "sparse") then "true" else "false"%>;
+   }
+
    const matrix_t& <%classname%>Mixed::getStateSetJacobian(unsigned int index)
    {
      switch (index)
@@ -13323,18 +13329,27 @@ case _ then
   let eqsCount = (jacobianColumn |> (eqs,vars,indxColumn) =>
     listLength(eqs)
     ;separator="+")
+  /* structurally orthogonal columns share a color and are seeded together,
+     so the column function runs once per color instead of once per column */
   let jacvals = if stringEq(eqsCount, "0") then '' else
-    (sparsepattern |> (index,indexes) hasindex index0 =>
-      let jaccol = ( indexes |> i_index hasindex index1 =>
-        (match indexColumn case "1" then '_<%matrixName%>jacobian(0,<%index%>) = _<%matrixName%>jac_y(0);/*test1<%index0%>,<%index1%>*/'
-           else '_<%matrixName%>jacobian(<%i_index%>,<%index%>) = _<%matrixName%>jac_y(<%i_index%>);/*test2<%index0%>,<%index1%>*/'
-           )
+    (colorList |> cols hasindex color0 =>
+      let seeds = (cols |> col => '_<%matrixName%>jac_x(<%col%>) = 1;' ;separator="\n")
+      let jaccols = (cols |> col =>
+        (sparsepattern |> (index,indexes) =>
+          if intEq(index, col) then
+            (indexes |> i_index =>
+              (match indexColumn case "1" then '_<%matrixName%>jacobian(0,<%index%>) = _<%matrixName%>jac_y(0);'
+                 else '_<%matrixName%>jacobian(<%i_index%>,<%index%>) = _<%matrixName%>jac_y(<%i_index%>);'
+                 )
+              ;separator="\n")
+          ;separator="\n")
         ;separator="\n")
     <<
-    _<%matrixName%>jac_x(<%index0%>) = 1;
+    /* color <%intAdd(color0,1)%> */
+    <%seeds%>
     calc<%matrixName%>JacobianColumn();
     _<%matrixName%>jac_x.clear();
-    <%jaccol%>
+    <%jaccols%>
     >>
     ;separator="\n")
   <<
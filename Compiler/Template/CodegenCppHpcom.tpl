@@ -139,6 +139,10 @@ template additionalHpcomIncludesForParallelCode(SimCode simCode, Text& extraFunc
       #include <tbb/task_arena.h>
       #endif
       >>
+    case ("taskpool") then
+      <<
+      #include <Core/Utils/extension/task_pool.hpp>
+      >>
     case ("mpi") then // MF: mpi.h
       <<
       #include <mpi.h>
@@ -287,7 +291,8 @@ template generateAdditionalFunctionHeaders(Option<tuple<Schedule,Schedule,Schedu
         case ("openmp") then
           <<
           >>
-        case ("tbb") then
+        case ("tbb")
+        case ("taskpool") then
           let voidfuncsOde = odeSchedule.tasks |> task => (
               match task
                 case ((task as CALCTASK(__),parents)) then
@@ -399,6 +404,21 @@ template generateAdditionalHpcomVarHeaders(Option<tuple<Schedule,Schedule,Schedu
           TbbArenaFunctor _tbbArenaFunctorZeroFunc;
           #endif
           >>
+        case ("taskpool") then
+          <<
+          TaskPool _taskPool;
+          TaskGraph _taskGraphOde;
+          TaskGraph _taskGraphAll;
+          TaskGraph _taskGraphZeroFunc;
+          <%if boolNot(stringEq(getConfigString(PROFILING_LEVEL),"none")) then
+          <<
+          #ifdef MEASURETIME_MODELFUNCTIONS
+          std::vector<MeasureTimeData*> *measureTimeTaskArrayHpcom_evaluateODE;
+          std::vector<MeasureTimeData*> *measureTimeTaskArrayHpcom_evaluateDAE;
+          std::vector<MeasureTimeData*> *measureTimeTaskArrayHpcom_evaluateZeroFuncs;
+          #endif //MEASURETIME_MODELFUNCTIONS
+          >>%>
+          >>
         else ""
       end match
     else ""
@@ -554,6 +574,12 @@ template additionalHpcomConstructorBodyStatements(Option<tuple<Schedule,Schedule
           <<
           <%tbbVars%>
           >>
+        case ("taskpool") then
+          <<
+          <%generateTaskPoolConstructorExtension(odeSchedule.tasks, "Ode", "evaluateODE", modelNamePrefixStr, fullModelName)%>
+          <%generateTaskPoolConstructorExtension(daeSchedule.tasks, "All", "evaluateDAE", modelNamePrefixStr, fullModelName)%>
+          <%generateTaskPoolConstructorExtension(zeroFuncSchedule.tasks, "ZeroFunc", "evaluateZeroFuncs", modelNamePrefixStr, fullModelName)%>
+          >>
         else ""
     else ""
   end match
@@ -729,6 +755,10 @@ template additionalHpcomDestructorBodyStatements(Option<tuple<Schedule,Schedule,
           for(std::vector<tbb::flow::continue_node<tbb::flow::continue_msg>* >::iterator it = _tbbNodeListZeroFunc.begin(); it != _tbbNodeListZeroFunc.end(); it++)
             delete *it;
           >>
+        case ("taskpool") then
+          <<
+          _taskPool.stop();
+          >>
         else ""
     else ""
   end match
@@ -1173,6 +1203,29 @@ template generateParallelEvaluate(list<SimEqSystem> allEquationsPlusWhen, Absyn.
             }
           }
           >>
+        case ("taskpool") then
+          let taskFuncs = function_HPCOM_TaskDep_voidfunc(odeSchedule.tasks, daeSchedule.tasks, zeroFuncSchedule.tasks, allEquationsPlusWhen,type, name, &varDecls, simCode, extraFuncs, extraFuncsDecl, extraFuncsNamespace, useFlatArrayNotation); separator="\n"
+          <<
+          //void functions executed by the task pool
+          <%taskFuncs%>
+
+          <%functionHead%>
+          {
+            this->_evaluateMode = _evaluateMode;
+            this->_command = command;
+            <%&varDecls%>
+            //the workers are started with the first evaluation, the thread count is a simulation setting (--solverThreads)
+            if(!_taskPool.isRunning())
+              _taskPool.start(getGlobalSettings()->getSolverThreads());
+
+            if(_evaluateMode == 0)
+              _taskPool.run(_taskGraphOde);
+            else if(_evaluateMode < 0)
+              _taskPool.run(_taskGraphAll);
+            else
+              _taskPool.run(_taskGraphZeroFunc);
+          }
+          >>
         else ""
       end match
     else ""
@@ -1449,6 +1502,38 @@ template generateTbbConstructorExtensionEdges(tuple<Task,list<Integer>> taskIn,
   end match
 end generateTbbConstructorExtensionEdges;
 
+template generateTaskPoolConstructorExtension(list<tuple<Task,list<Integer>>> tasks, String funcSuffix, String measureSuffix, String modelNamePrefixStr, String fullModelName)
+::=
+  let taskNodes = tasks |> taskIn => (
+      match taskIn
+        case ((task as CALCTASK(__),parents)) then
+          '_taskGraph<%funcSuffix%>.addTask(bind<void>(&<%modelNamePrefixStr%>::taskFunc<%funcSuffix%>_<%task.index%>,this));'
+      ); separator="\n"
+  let taskEdges = tasks |> taskIn hasindex i fromindex 0 => (
+      match taskIn
+        case ((task as CALCTASK(__),parents)) then
+          (parents |> p => '_taskGraph<%funcSuffix%>.addEdge(<%intSub(p,1)%>,<%i%>);'; separator="\n")
+      ); separator="\n"
+  <<
+  <%taskNodes%>
+  <%taskEdges%>
+  <%if boolNot(stringEq(getConfigString(PROFILING_LEVEL),"none")) then
+    <<
+    #ifdef MEASURETIME_MODELFUNCTIONS
+    measureTimeTaskArrayHpcom_<%measureSuffix%> = new std::vector<MeasureTimeData*>(size_t(<%listLength(tasks)%>), NULL);
+    MeasureTime::addResultContentBlock("<%fullModelName%>","functions_HPCOM_Tasks_<%funcSuffix%>",measureTimeTaskArrayHpcom_<%measureSuffix%>);
+    <%tasks |> taskIn hasindex i fromindex 0 => (
+        match taskIn
+          case ((task as CALCTASK(__),_)) then
+            '(*measureTimeTaskArrayHpcom_<%measureSuffix%>)[<%i%>] = new MeasureTimeData("<%funcSuffix%>_task_<%task.index%>");'
+        ); separator="\n"%>
+    _taskGraph<%funcSuffix%>.setMeasurements(measureTimeTaskArrayHpcom_<%measureSuffix%>);
+    #endif //MEASURETIME_MODELFUNCTIONS
+    >>
+  %>
+  >>
+end generateTaskPoolConstructorExtension;
+
 template function_HPCOM_TaskDep_voidfunc(list<tuple<Task,list<Integer>>> odeTasks, list<tuple<Task,list<Integer>>> daeTasks, list<tuple<Task,list<Integer>>> zeroFuncTasks, list<SimEqSystem> allEquationsPlusWhen,
                                          String iType, Absyn.Path name, Text &varDecls, SimCode simCode, Text& extraFuncs, Text& extraFuncsDecl, Text extraFuncsNamespace, Boolean useFlatArrayNotation)
 ::=
@@ -44,6 +44,7 @@
 #include "BackendDAEEXT.cpp"
 #include <stdlib.h>
 #include "errorext.h"
+#include "coloring.h"
 
 extern "C" {
 
@@ -173,6 +174,65 @@ extern void BackendDAEEXT_getAssignment(modelica_metatype ass1, modelica_metatyp
   }
 }
 
+/* fill ptrs/ids with the 0-based compressed form of an array of 1-based index lists */
+static int BackendDAEEXT_compressPattern(modelica_metatype pattern, int n, int maxIndex, int *ptrs, int **ids)
+{
+  int i, j = 0;
+  mmc_sint_t idx;
+  modelica_metatype lst;
+
+  for(i=0; i<n; ++i) {
+    ptrs[i] = j;
+    for(lst = MMC_STRUCTDATA(pattern)[i]; MMC_GETHDR(lst) == MMC_CONSHDR; lst = MMC_CDR(lst)) {
+      j++;
+    }
+  }
+  ptrs[n] = j;
+  *ids = (int*) malloc((j > 0 ? j : 1) * sizeof(int));
+  for(i=0, j=0; i<n; ++i) {
+    for(lst = MMC_STRUCTDATA(pattern)[i]; MMC_GETHDR(lst) == MMC_CONSHDR; lst = MMC_CDR(lst)) {
+      idx = MMC_UNTAGFIXNUM(MMC_CAR(lst));
+      if (idx < 1 || idx > maxIndex) {
+        return 1;
+      }
+      (*ids)[j++] = (int)idx-1;
+    }
+  }
+  return 0;
+}
+
+extern int BackendDAEEXT_partialDistance2coloring(modelica_metatype sparseArrayT, modelica_metatype sparseArray, int ordering, modelica_metatype colored)
+{
+  int i, nColors, fail;
+  int n = MMC_HDRSLOTS(MMC_GETHDR(sparseArrayT));
+  int m = MMC_HDRSLOTS(MMC_GETHDR(sparseArray));
+  int *col_ptrs, *col_ids = NULL, *row_ptrs, *row_ids = NULL, *color;
+
+  if (n > (int) MMC_HDRSLOTS(MMC_GETHDR(colored))) {
+    c_add_message(NULL,-1,ErrorType_symbolic,ErrorLevel_internal,"BackendDAEEXT.partialDistance2coloring failed because the color array is too small",NULL,0);
+    MMC_THROW();
+  }
+  col_ptrs = (int*) malloc((n+1) * sizeof(int));
+  row_ptrs = (int*) malloc((m+1) * sizeof(int));
+  color = (int*) malloc((n > 0 ? n : 1) * sizeof(int));
+  fail = BackendDAEEXT_compressPattern(sparseArrayT, n, m, col_ptrs, &col_ids);
+  fail = fail || BackendDAEEXT_compressPattern(sparseArray, m, n, row_ptrs, &row_ids);
+  nColors = fail ? -1 : partialDistance2Coloring(n, col_ptrs, col_ids, row_ptrs, row_ids, ordering, color);
+  for(i=0; i<n && nColors >= 0; ++i) {
+    MMC_STRUCTDATA(colored)[i] = mmc_mk_icon(color[i]);
+  }
+  free(col_ptrs);
+  free(col_ids);
+  free(row_ptrs);
+  free(row_ids);
+  free(color);
+  if (nColors < 0) {
+    c_add_message(NULL,-1,ErrorType_symbolic,ErrorLevel_internal,"BackendDAEEXT.partialDistance2coloring failed because of an invalid sparsity pattern",NULL,0);
+    MMC_THROW();
+  }
+  return nColors;
+}
+
 extern int BackendDAEEXT_setAssignment(int lenass1, int lenass2, modelica_metatype ass1, modelica_metatype ass2)
 {
   int nelts=0;
@@ -201,6 +201,197 @@ static double SimulationResultsImpl__val(const char *filename, const char *varna
   }
 }
 
+/* Interpolates the column vals at time, where times is sorted ascending.
+ * At events (identical time stamps) the right limit is used, like in val().
+ * Returns 0 on success and 1 if time is outside of [times[0],times[n-1]]. */
+static int interpolateColumn(const double *times, const double *vals, int n, double time, double *res)
+{
+  int lo = 0, hi = n;
+  double w;
+  if (n <= 0 || time < times[0] || time > times[n-1]) {
+    return 1;
+  }
+  /* Find the first index with times[lo] > time */
+  while (lo < hi) {
+    int mid = lo + (hi-lo)/2;
+    if (times[mid] <= time) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
+  if (lo == n || times[lo-1] == time) {
+    *res = vals[lo-1];
+    return 0;
+  }
+  w = (time - times[lo-1]) / (times[lo] - times[lo-1]);
+  *res = vals[lo-1]*(1.0-w) + vals[lo]*w;
+  return 0;
+}
+
+/* Makes the list of values of a column at all requested time points */
+static void* interpolateColumnList(const char *varname, const double *times, const double *vals, int n, const double *timeStamps, int nTimeStamps)
+{
+  const char *msg[2] = {"",""};
+  void *res = mmc_mk_nil();
+  double v;
+  int i;
+  for (i=nTimeStamps-1; i>=0; i--) {
+    if (interpolateColumn(times, vals, n, timeStamps[i], &v)) {
+      char buf[64];
+      snprintf(buf,60,"%g",timeStamps[i]);
+      msg[1] = varname;
+      msg[0] = buf;
+      c_add_message(NULL,-1, ErrorType_scripting, ErrorLevel_error, gettext("%s not defined at time %s\n"), msg, 2);
+      return NULL;
+    }
+    res = mmc_mk_cons(mmc_mk_rcon(v),res);
+  }
+  return res;
+}
+
+/* Reads the plt datasets of all given variables in a single pass over the file.
+ * The datasets are returned in pltTimes/pltVals/pltSizes, indexed like vars. */
+static int SimulationResultsImpl__readPltColumns(FILE *fin, const char **vars, int nvars, double **pltTimes, double **pltVals, int *pltSizes)
+{
+  char line[255];
+  int cur = -1, capacity = 0, i, nfound = 0;
+  fseek(fin,0,SEEK_SET);
+  while (NULL != fgets(line,255,fin)) {
+    double t,v;
+    if (0 == strncmp(line,"DataSet: ",9)) {
+      char *name = line+9;
+      name[strcspn(name,"\r\n")] = '\0';
+      cur = -1;
+      for (i=0; i<nvars; i++) {
+        if (pltTimes[i] == NULL && 0 == strcmp(vars[i],name)) {
+          cur = i;
+          capacity = 1024;
+          pltTimes[i] = (double*) malloc(capacity*sizeof(double));
+          pltVals[i] = (double*) malloc(capacity*sizeof(double));
+          pltSizes[i] = 0;
+          nfound++;
+          break;
+        }
+      }
+    } else if (cur >= 0 && sscanf(line,"%lg, %lg",&t,&v) == 2) {
+      if (pltSizes[cur] == capacity) {
+        capacity *= 2;
+        pltTimes[cur] = (double*) realloc(pltTimes[cur], capacity*sizeof(double));
+        pltVals[cur] = (double*) realloc(pltVals[cur], capacity*sizeof(double));
+      }
+      pltTimes[cur][pltSizes[cur]] = t;
+      pltVals[cur][pltSizes[cur]] = v;
+      pltSizes[cur]++;
+    }
+  }
+  return nfound;
+}
+
+/* Returns the values of all vars at all timeStamps as a list of rows (one row
+ * per variable), or NULL on failure. Each variable is read at most once and
+ * the reader is only positioned once for the whole batch, which is much
+ * cheaper than calling val() for each (variable,time) pair. */
+static void* SimulationResultsImpl__vals(const char *filename, void *vars, void *timeStampsLst, SimulationResult_Globals* simresglob)
+{
+  const char *msg[2] = {"",""};
+  void *res = NULL, *row, *tmp;
+  const char **varnames;
+  double *timeStamps;
+  int nvars = listLength(vars), nTimeStamps = listLength(timeStampsLst), i, j;
+
+  if (UNKNOWN_PLOT == SimulationResultsImpl__openFile(filename,simresglob)) {
+    return NULL;
+  }
+  varnames = (const char**) malloc((nvars+1)*sizeof(const char*));
+  timeStamps = (double*) malloc((nTimeStamps+1)*sizeof(double));
+  for (i=0, tmp=vars; i<nvars; i++, tmp=MMC_CDR(tmp)) {
+    varnames[i] = MMC_STRINGDATA(MMC_CAR(tmp));
+  }
+  for (i=0, tmp=timeStampsLst; i<nTimeStamps; i++, tmp=MMC_CDR(tmp)) {
+    timeStamps[i] = mmc_prim_get_real(MMC_CAR(tmp));
+  }
+
+  switch (simresglob->curFormat) {
+  case MATLAB4: {
+    ModelicaMatVariable_t *mat_var;
+    double *times = omc_matlab4_read_vals(&simresglob->matReader,1);
+    int nrows = simresglob->matReader.nrows;
+    res = mmc_mk_nil();
+    for (i=nvars-1; i>=0 && res; i--) {
+      mat_var = omc_matlab4_find_var(&simresglob->matReader,varnames[i]);
+      if (mat_var == NULL) {
+        msg[1] = varnames[i];
+        msg[0] = filename;
+        c_add_message(NULL,-1, ErrorType_scripting, ErrorLevel_error, gettext("%s not found in %s\n"), msg, 2);
+        res = NULL;
+      } else if (mat_var->isParam) {
+        double param = simresglob->matReader.params[abs(mat_var->index)-1];
+        if (mat_var->index < 0) param = -param;
+        row = mmc_mk_nil();
+        for (j=0; j<nTimeStamps; j++) row = mmc_mk_cons(mmc_mk_rcon(param),row);
+        res = mmc_mk_cons(row,res);
+      } else {
+        double *vals = omc_matlab4_read_vals(&simresglob->matReader,mat_var->index);
+        row = (times && vals) ? interpolateColumnList(varnames[i],times,vals,nrows,timeStamps,nTimeStamps) : NULL;
+        res = row ? mmc_mk_cons(row,res) : NULL;
+      }
+    }
+    break;
+  }
+  case PLT: {
+    double **pltTimes = (double**) calloc(nvars+1,sizeof(double*));
+    double **pltVals = (double**) calloc(nvars+1,sizeof(double*));
+    int *pltSizes = (int*) calloc(nvars+1,sizeof(int));
+    SimulationResultsImpl__readPltColumns(simresglob->pltReader,varnames,nvars,pltTimes,pltVals,pltSizes);
+    res = mmc_mk_nil();
+    for (i=nvars-1; i>=0 && res; i--) {
+      if (pltTimes[i] == NULL) {
+        msg[1] = varnames[i];
+        msg[0] = filename;
+        c_add_message(NULL,-1, ErrorType_scripting, ErrorLevel_error, gettext("%s not found in %s\n"), msg, 2);
+        res = NULL;
+      } else {
+        row = interpolateColumnList(varnames[i],pltTimes[i],pltVals[i],pltSizes[i],timeStamps,nTimeStamps);
+        res = row ? mmc_mk_cons(row,res) : NULL;
+      }
+    }
+    for (i=0; i<nvars; i++) {
+      free(pltTimes[i]);
+      free(pltVals[i]);
+    }
+    free(pltTimes);
+    free(pltVals);
+    free(pltSizes);
+    break;
+  }
+  case CSV: {
+    double *times = simresglob->csvReader ? read_csv_dataset(simresglob->csvReader,"time") : NULL;
+    res = mmc_mk_nil();
+    for (i=nvars-1; i>=0 && res; i--) {
+      double *vals = simresglob->csvReader ? read_csv_dataset(simresglob->csvReader,varnames[i]) : NULL;
+      if (vals == NULL || times == NULL) {
+        msg[1] = varnames[i];
+        msg[0] = filename;
+        c_add_message(NULL,-1, ErrorType_scripting, ErrorLevel_error, gettext("%s not found in %s\n"), msg, 2);
+        res = NULL;
+      } else {
+        row = interpolateColumnList(varnames[i],times,vals,simresglob->csvReader->numsteps,timeStamps,nTimeStamps);
+        res = row ? mmc_mk_cons(row,res) : NULL;
+      }
+    }
+    break;
+  }
+  default:
+    msg[0] = PlotFormatStr[simresglob->curFormat];
+    c_add_message(NULL,-1, ErrorType_scripting, ErrorLevel_error, gettext("vals() not implemented for plot format: %s\n"), msg, 1);
+    break;
+  }
+  free(varnames);
+  free(timeStamps);
+  return res;
+}
+
 static int SimulationResultsImpl__readSimulationResultSize(const char *filename, SimulationResult_Globals* simresglob)
 {
   const char *msg[2] = {"",""};
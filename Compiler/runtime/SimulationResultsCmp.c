@@ -528,8 +528,125 @@ static const char* getTimeVarName(void *vars) {
 
 #include "SimulationResultsCmpTubes.c"
 
+/* Number of variables handed to each thread per chunk; bounds the amount of
+ * data that is kept in memory at the same time */
+#define CMP_VARS_PER_THREAD 16
+
+typedef struct {
+  char *var;
+  DataField data;
+  DataField dataref;
+  DiffDataField ddf;
+  char *diffvar;
+  void *diffLst;
+} CmpTask;
+
+typedef struct {
+  pthread_mutex_t *mutex;
+  unsigned int *current;
+  unsigned int size;
+  CmpTask *tasks;
+  DataField *time;
+  DataField *timeref;
+  int isResultCmp;
+  double reltol;
+  double abstol;
+  double reltolDiffMaxMin;
+  double rangeDelta;
+  int keepEqualResults;
+  const char *prefix;
+  int isHtml;
+  char **htmlOut;
+} CmpWorkerArgs;
+
+/* Reads the values of a variable directly from the already opened reader.
+ * Does not go through a MetaModelica list like getData, which is used as
+ * fallback (and for the error messages) */
+static DataField getDataDirect(const char *varname, const char *filename, unsigned int size, int suggestReadAll, SimulationResult_Globals* srg, int runningTestsuite)
+{
+  DataField res;
+  double *vals = NULL;
+  unsigned int i;
+  res.n = 0;
+  res.data = NULL;
+
+  if (UNKNOWN_PLOT == SimulationResultsImpl__openFile(filename,srg)) {
+    return res;
+  }
+  switch (srg->curFormat) {
+  case MATLAB4: {
+    ModelicaMatVariable_t *mat_var = omc_matlab4_find_var(&srg->matReader,varname);
+    if (mat_var == NULL || size == 0 || srg->matReader.nrows != size) {
+      break;
+    }
+    if (suggestReadAll) {
+      omc_matlab4_read_all_vals(&srg->matReader);
+    }
+    res.data = (double*) malloc(sizeof(double)*size);
+    if (mat_var->isParam) {
+      double val = srg->matReader.params[abs(mat_var->index)-1];
+      if (mat_var->index < 0) {
+        val = -val;
+      }
+      for (i=0;i<size;i++) {
+        res.data[i] = val;
+      }
+    } else {
+      vals = omc_matlab4_read_vals(&srg->matReader,mat_var->index);
+      if (vals == NULL) {
+        free(res.data);
+        res.data = NULL;
+        break;
+      }
+      memcpy(res.data, vals, sizeof(double)*size);
+    }
+    res.n = size;
+    return res;
+  }
+  case CSV: {
+    vals = srg->csvReader ? read_csv_dataset(srg->csvReader,varname) : NULL;
+    if (vals == NULL || size == 0) {
+      break;
+    }
+    res.data = (double*) malloc(sizeof(double)*size);
+    memcpy(res.data, vals, sizeof(double)*size);
+    res.n = size;
+    return res;
+  }
+  default:
+    break;
+  }
+  return getData(varname,filename,size,suggestReadAll,srg,runningTestsuite);
+}
+
+static void runCmpTask(CmpWorkerArgs *arg, CmpTask *task)
+{
+  if (arg->isHtml) {
+    cmpDataTubes(0,task->var,arg->time,arg->timeref,&task->data,&task->dataref,arg->reltol,arg->rangeDelta,arg->reltolDiffMaxMin,&task->ddf,&task->diffvar,0,arg->keepEqualResults,&task->diffLst,arg->prefix,1,arg->htmlOut);
+  } else if (arg->isResultCmp) {
+    cmpData(1,task->var,arg->time,arg->timeref,&task->data,&task->dataref,arg->reltol,arg->abstol,&task->ddf,&task->diffvar,0,arg->keepEqualResults,&task->diffLst,arg->prefix);
+  } else {
+    cmpDataTubes(0,task->var,arg->time,arg->timeref,&task->data,&task->dataref,arg->reltol,arg->rangeDelta,arg->reltolDiffMaxMin,&task->ddf,&task->diffvar,0,arg->keepEqualResults,&task->diffLst,arg->prefix,0,0);
+  }
+}
+
+static void* cmpWorkerThread(void *argVoid)
+{
+  CmpWorkerArgs *arg = (CmpWorkerArgs*) argVoid;
+  while (1) {
+    unsigned int i;
+    pthread_mutex_lock(arg->mutex);
+    i = (*arg->current);
+    *arg->current+=1;
+    pthread_mutex_unlock(arg->mutex);
+    if (i >= arg->size) break;
+    runCmpTask(arg, &arg->tasks[i]);
+  };
+  return NULL;
+}
+
 /* Common, huge function, for both result comparison and result diff */
-void* SimulationResultsCmp_compareResults(int isResultCmp, int runningTestsuite, const char *filename, const char *reffilename, const char *resultfilename, double reltol, double abstol, double reltolDiffMaxMin, double rangeDelta, void *vars, int keepEqualResults, int *success, int isHtml, char **htmlOut)
+void* SimulationResultsCmp_compareResults(int isResultCmp, int runningTestsuite, const char *filename, const char *reffilename, const char *resultfilename, double reltol, double abstol, double reltolDiffMaxMin, double rangeDelta, void *vars, int keepEqualResults, int *success, int isHtml, char **htmlOut, int numThreads)
 {
   char **cmpvars=NULL;
   char **cmpdiffvars=NULL;
@@ -538,9 +655,12 @@ void* SimulationResultsCmp_compareResults(int isResultCmp, int runningTestsuite,
   unsigned int ngetfailedvars = 0;
   void *allvars,*allvarsref,*res;
   unsigned int i,size,size_ref,len,j,k;
-  char *var,*var1,*var2;
-  DataField time,timeref,data,dataref;
+  char *var,*var1;
+  DataField time,timeref;
   DiffDataField ddf;
+  CmpTask *tasks;
+  CmpWorkerArgs args;
+  unsigned int chunkSize,current;
   const char *msg[2] = {"",""};
   const char *timeVarName, *timeVarNameRef;
   int suggestReadAll=0;
@@ -617,79 +737,134 @@ void* SimulationResultsCmp_compareResults(int isResultCmp, int runningTestsuite,
     "File[%d]=%f\n",timeref.n,timeref.data[timeref.n-1],time.n,time.data[time.n-1]);
     c_add_message(NULL,-1, ErrorType_scripting, ErrorLevel_warning, buf, NULL, 0);
   }
-  var1=NULL;
-  var2=NULL;
   /* compare vars */
   /* fprintf(stderr, "compare vars\n"); */
-  for (i=0;i<ncmpvars;i++) {
-    var = cmpvars[i];
-    len = strlen(var);
-    if (var1) {
-      free(var1);
-      var1 = NULL;
-    }
-    var1 = (char*) omc_alloc_interface.malloc(len+10);
-    k = 0;
-    for (j=0;j<len;j++) {
-      if (var[j] !='\"' ) {
-        var1[k] = var[j];
-        k +=1;
-      }
-    }
-    var1[k] = 0;
-    /* fprintf(stderr, "compare var: %s\n",var); */
-    /* check if in ref_file */
-    dataref = getData(var1,reffilename,size_ref,suggestReadAll,&simresglob_ref,runningTestsuite);
-    if (dataref.n==0) {
-      if (dataref.data) {
-        free(dataref.data);
+  if (numThreads < 1 || isHtml) {
+    numThreads = 1;
+  }
+  if (numThreads > ncmpvars) {
+    numThreads = ncmpvars;
+  }
+  chunkSize = numThreads > 1 ? numThreads*CMP_VARS_PER_THREAD : 1;
+  /* GC memory: the diff lists of the tasks are only reachable from here until they are merged */
+  tasks = (CmpTask*) omc_alloc_interface.malloc(chunkSize*sizeof(CmpTask));
+  args.time = &time;
+  args.timeref = &timeref;
+  args.isResultCmp = isResultCmp;
+  args.reltol = reltol;
+  args.abstol = abstol;
+  args.reltolDiffMaxMin = reltolDiffMaxMin;
+  args.rangeDelta = rangeDelta;
+  args.keepEqualResults = keepEqualResults;
+  args.prefix = resultfilename;
+  args.isHtml = isHtml;
+  args.htmlOut = htmlOut;
+  args.tasks = tasks;
+  for (i=0;i<ncmpvars;) {
+    unsigned int ntasks = 0;
+    /* Read the data of the next chunk of variables; the readers are not thread-safe */
+    for (;i<ncmpvars && ntasks<chunkSize;i++) {
+      CmpTask *task = &tasks[ntasks];
+      memset(task, 0, sizeof(CmpTask));
+      var = cmpvars[i];
+      len = strlen(var);
+      var1 = (char*) omc_alloc_interface.malloc_atomic(len+10);
+      k = 0;
+      for (j=0;j<len;j++) {
+        if (var[j] !='\"' ) {
+          var1[k] = var[j];
+          k +=1;
+        }
       }
-      if (var1) {
+      var1[k] = 0;
+      /* fprintf(stderr, "compare var: %s\n",var); */
+      /* check if in ref_file */
+      task->dataref = getDataDirect(var1,reffilename,size_ref,suggestReadAll,&simresglob_ref,runningTestsuite);
+      if (task->dataref.n==0) {
+        if (task->dataref.data) {
+          free(task->dataref.data);
+        }
         GC_free(var1);
-        var1 = NULL;
-      }
-      msg[0] = runningTestsuite ? SystemImpl__basename(reffilename) : reffilename;
-      msg[1] = var;
-      c_add_message(NULL,-1, ErrorType_scripting, ErrorLevel_warning, gettext("Get data of variable %s from file %s failed!\n"), msg, 2);
-      ngetfailedvars++;
-      continue;
-    }
-    /*  check if in file */
-    data = getData(var1,filename,size,suggestReadAll,&simresglob_c,runningTestsuite);
-    if (data.n==0)  {
-      if (data.data) {
-        free(data.data);
+        msg[0] = runningTestsuite ? SystemImpl__basename(reffilename) : reffilename;
+        msg[1] = var;
+        c_add_message(NULL,-1, ErrorType_scripting, ErrorLevel_warning, gettext("Get data of variable %s from file %s failed!\n"), msg, 2);
+        ngetfailedvars++;
+        continue;
       }
-      if (var1) {
-        GC_free(var1);
-        var1 = NULL;
+      /*  check if in file */
+      task->data = getDataDirect(var1,filename,size,suggestReadAll,&simresglob_c,runningTestsuite);
+      GC_free(var1);
+      if (task->data.n==0)  {
+        if (task->data.data) {
+          free(task->data.data);
+        }
+        free(task->dataref.data);
+        msg[0] = runningTestsuite ? SystemImpl__basename(filename) : filename;
+        msg[1] = var;
+        c_add_message(NULL,-1, ErrorType_scripting, ErrorLevel_warning, gettext("Get data of variable %s from file %s failed!\n"), msg, 2);
+        ngetfailedvars++;
+        continue;
       }
-      msg[0] = runningTestsuite ? SystemImpl__basename(filename) : filename;
-      msg[1] = var;
-      c_add_message(NULL,-1, ErrorType_scripting, ErrorLevel_warning, gettext("Get data of variable %s from file %s failed!\n"), msg, 2);
-      ngetfailedvars++;
-      continue;
+      task->var = var;
+      task->diffLst = mmc_mk_nil();
+      ntasks++;
     }
     /* compare */
-    if (isHtml) {
-      vardiffindx = cmpDataTubes(isResultCmp,var,&time,&timeref,&data,&dataref,reltol,rangeDelta,reltolDiffMaxMin,&ddf,cmpdiffvars,vardiffindx,keepEqualResults,&res,resultfilename,1,htmlOut);
-    } else if (isResultCmp) {
-      vardiffindx = cmpData(isResultCmp,var,&time,&timeref,&data,&dataref,reltol,abstol,&ddf,cmpdiffvars,vardiffindx,keepEqualResults,&res,resultfilename);
+    args.size = ntasks;
+    current = 0;
+    if (numThreads == 1 || ntasks == 1) {
+      for (j=0;j<ntasks;j++) {
+        runCmpTask(&args, &tasks[j]);
+      }
     } else {
-      vardiffindx = cmpDataTubes(isResultCmp,var,&time,&timeref,&data,&dataref,reltol,rangeDelta,reltolDiffMaxMin,&ddf,cmpdiffvars,vardiffindx,keepEqualResults,&res,resultfilename,0,0);
-    }
-    /* free */
-    if (dataref.data) {
-      free(dataref.data);
-    }
-    if (data.data) {
-      free(data.data);
+      pthread_mutex_t mutex;
+      pthread_t *th = (pthread_t*) omc_alloc_interface.malloc(sizeof(pthread_t)*numThreads);
+      pthread_mutex_init(&mutex,NULL);
+      args.mutex = &mutex;
+      args.current = &current;
+      for (j=0; j<numThreads; j++) {
+        GC_pthread_create(&th[j],NULL,cmpWorkerThread,&args);
+      }
+      for (j=0; j<numThreads; j++) {
+        GC_pthread_join(th[j], NULL);
+      }
+      GC_free(th);
+      pthread_mutex_destroy(&mutex);
     }
-    if (var1) {
-      GC_free(var1);
-      var1 = NULL;
+    /* Merge the results in the order of the variables so the output does not depend on the scheduling */
+    for (j=0;j<ntasks;j++) {
+      CmpTask *task = &tasks[j];
+      if (task->diffvar) {
+        cmpdiffvars[vardiffindx++] = task->diffvar;
+      }
+      if (MMC_NILHDR != MMC_GETHDR(task->diffLst)) {
+        res = mmc_mk_cons(MMC_CAR(task->diffLst),res);
+      }
+      if (task->ddf.n > 0) {
+        if (ddf.n + task->ddf.n > ddf.n_max) {
+          DiffData *newData;
+          ddf.n_max = ddf.n + task->ddf.n;
+          newData = (DiffData*) realloc(ddf.data, sizeof(DiffData)*(ddf.n_max));
+          if (newData) {
+            ddf.data = newData;
+          } else {
+            ddf.n_max = ddf.n; /* realloc failed... pretty bad, but let's continue */
+          }
+        }
+        if (ddf.n + task->ddf.n <= ddf.n_max) {
+          memcpy(ddf.data + ddf.n, task->ddf.data, sizeof(DiffData)*task->ddf.n);
+          ddf.n += task->ddf.n;
+        }
+      }
+      /* free */
+      if (task->ddf.data) {
+        free(task->ddf.data);
+      }
+      free(task->dataref.data);
+      free(task->data.data);
     }
   }
+  GC_free(tasks);
 
   if (isResultCmp) {
     if (writeLogFile(resultfilename,&ddf,filename,reffilename,reltol,abstol)) {
@@ -714,8 +889,6 @@ void* SimulationResultsCmp_compareResults(int isResultCmp, int runningTestsuite,
     }
   }
 
-  // if (var1) free(var1);
-  // if (var2) free(var2);
   if (ddf.data) free(ddf.data);
   if (cmpvars) GC_free(cmpvars);
   if (time.data) free(time.data);
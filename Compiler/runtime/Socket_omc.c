@@ -47,3 +47,21 @@ extern const char* Socket_handlerequest(int sock)
   free(str);
   return res;
 }
+
+#define MAX_REQUESTS MAX_CLIENTS
+
+extern modelica_metatype Socket_handlerequests(threadData_t *threadData)
+{
+  int socks[MAX_REQUESTS], i, n;
+  char *reqs[MAX_REQUESTS];
+  modelica_metatype res = mmc_mk_nil();
+  n = SocketImpl_handlerequests(socks, reqs, MAX_REQUESTS);
+  if (n < 0) {
+    MMC_THROW_INTERNAL();
+  }
+  for (i=n-1; i>=0; i--) {
+    res = mmc_mk_cons(mmc_mk_box2(0, mmc_mk_icon(socks[i]), mmc_mk_scon(reqs[i])), res);
+    free(reqs[i]);
+  }
+  return res;
+}
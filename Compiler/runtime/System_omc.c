@@ -266,52 +266,52 @@ extern int System_strcmp_offset(const char *str1, int offset1, int length1, cons
 
 extern int System_getHasExpandableConnectors()
 {
-  return hasExpandableConnectors;
+  return getSystemMoData(NULL)->hasExpandableConnectors;
 }
 
 extern void System_setHasExpandableConnectors(int b)
 {
-  hasExpandableConnectors = b;
+  getSystemMoData(NULL)->hasExpandableConnectors = b;
 }
 
 extern int System_getPartialInstantiation()
 {
-  return isPartialInstantiation;
+  return getSystemMoData(NULL)->isPartialInstantiation;
 }
 
 extern void System_setPartialInstantiation(int b)
 {
-  isPartialInstantiation = b;
+  getSystemMoData(NULL)->isPartialInstantiation = b;
 }
 
 extern int System_getHasInnerOuterDefinitions()
 {
-  return hasInnerOuterDefinitions;
+  return getSystemMoData(NULL)->hasInnerOuterDefinitions;
 }
 
 extern void System_setHasInnerOuterDefinitions(int b)
 {
-  hasInnerOuterDefinitions = b;
+  getSystemMoData(NULL)->hasInnerOuterDefinitions = b;
 }
 
 extern int System_getHasStreamConnectors()
 {
-  return hasStreamConnectors;
+  return getSystemMoData(NULL)->hasStreamConnectors;
 }
 
 extern void System_setHasStreamConnectors(int b)
 {
-  hasStreamConnectors = b;
+  getSystemMoData(NULL)->hasStreamConnectors = b;
 }
 
 extern int System_getUsesCardinality()
 {
-  return usesCardinality;
+  return getSystemMoData(NULL)->usesCardinality;
 }
 
 extern void System_setUsesCardinality(int b)
 {
-  usesCardinality = b;
+  getSystemMoData(NULL)->usesCardinality = b;
 }
 
 extern void* System_strtok(const char *str0, const char *delimit)
@@ -766,6 +766,8 @@ static void* System_launchParallelTasksThread(void *in)
     MMC_TRY_TOP()
     threadData->parent = data->parent;
     threadData->mmc_thread_work_exit = threadData->mmc_jumper;
+    /* Start from the user-defined roots (flags, caches) of the parent thread */
+    memcpy(threadData->localRoots, data->parent->localRoots, (LOCAL_ROOT_USER_DEFINED_8+1)*sizeof(void*));
     data->status[n] = data->fn(threadData,data->commands[n]);
     fail = 0;
     MMC_CATCH_TOP()
@@ -783,7 +785,7 @@ static void* System_launchParallelTasksSerial(threadData_t *threadData, void *da
     result = mmc_mk_cons(fn(threadData, MMC_CAR(dataLst)),result);
     dataLst = MMC_CDR(dataLst);
   }
-  return listReverse(dataLst);
+  return listReverse(result);
 }
 
 extern void* System_launchParallelTasks(threadData_t *threadData, int numThreads, void *dataLst, modelica_metatype (*fn)(threadData_t *,modelica_metatype))
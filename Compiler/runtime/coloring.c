@@ -0,0 +1,293 @@
+/*
+ * This file is part of OpenModelica.
+ *
+ * Copyright (c) 1998-2010, Linköpings University,
+ * Department of Computer and Information Science,
+ * SE-58183 Linköping, Sweden.
+ *
+ * All rights reserved.
+ *
+ * THIS PROGRAM IS PROVIDED UNDER THE TERMS OF THIS OSMC PUBLIC
+ * LICENSE (OSMC-PL). ANY USE, REPRODUCTION OR DISTRIBUTION OF
+ * THIS PROGRAM CONSTITUTES RECIPIENT'S ACCEPTANCE OF THE OSMC
+ * PUBLIC LICENSE.
+ *
+ * The OpenModelica software and the Open Source Modelica
+ * Consortium (OSMC) Public License (OSMC-PL) are obtained
+ * from Linköpings University, either from the above address,
+ * from the URL: http://www.ida.liu.se/projects/OpenModelica
+ * and in the OpenModelica distribution.
+ *
+ * This program is distributed  WITHOUT ANY WARRANTY; without
+ * even the implied warranty of  MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE, EXCEPT AS EXPRESSLY SET FORTH
+ * IN THE BY RECIPIENT SELECTED SUBSIDIARY LICENSE CONDITIONS
+ * OF OSMC-PL.
+ *
+ * See the full OSMC Public License conditions for more details.
+ *
+ */
+
+/*
+ * file:        coloring.c
+ * description: Greedy partial distance-2 coloring on compressed sparse
+ *              arrays, see coloring.h.
+ *
+ *              The degree of a column used by the ordering heuristics is the
+ *              number of (column, row, column) paths, i.e. neighbours sharing
+ *              several rows are counted several times. This avoids building
+ *              the column intersection graph and gives the same orderings as
+ *              the exact degree for the usual Jacobian patterns.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "coloring.h"
+
+/* bucket list of columns keyed by degree */
+typedef struct {
+  int* head;    /* first column with degree d */
+  int* next;
+  int* prev;
+  int* degree;
+  int maxDegree;
+} BUCKETS;
+
+static int allocBuckets(BUCKETS* b, int n, int maxDegree)
+{
+  b->maxDegree = maxDegree;
+  b->head = (int*) malloc((maxDegree+1) * sizeof(int));
+  b->next = (int*) malloc(n * sizeof(int));
+  b->prev = (int*) malloc(n * sizeof(int));
+  b->degree = (int*) malloc(n * sizeof(int));
+  if (!b->head || !b->next || !b->prev || !b->degree) {
+    return 1;
+  }
+  memset(b->head, -1, (maxDegree+1) * sizeof(int));
+  return 0;
+}
+
+static void freeBuckets(BUCKETS* b)
+{
+  free(b->head);
+  free(b->next);
+  free(b->prev);
+  free(b->degree);
+}
+
+static void bucketInsert(BUCKETS* b, int i, int d)
+{
+  b->degree[i] = d;
+  b->prev[i] = -1;
+  b->next[i] = b->head[d];
+  if (b->head[d] >= 0) {
+    b->prev[b->head[d]] = i;
+  }
+  b->head[d] = i;
+}
+
+static void bucketRemove(BUCKETS* b, int i)
+{
+  if (b->prev[i] >= 0) {
+    b->next[b->prev[i]] = b->next[i];
+  } else {
+    b->head[b->degree[i]] = b->next[i];
+  }
+  if (b->next[i] >= 0) {
+    b->prev[b->next[i]] = b->prev[i];
+  }
+}
+
+/* number of (column, row, column) paths starting in every column */
+static int pathDegrees(int n, const int* col_ptrs, const int* col_ids, const int* row_ptrs, int* degree)
+{
+  int i, k, maxDegree = 0;
+  for (i = 0; i < n; ++i) {
+    degree[i] = 0;
+    for (k = col_ptrs[i]; k < col_ptrs[i+1]; ++k) {
+      degree[i] += row_ptrs[col_ids[k]+1] - row_ptrs[col_ids[k]] - 1;
+    }
+    if (degree[i] > maxDegree) {
+      maxDegree = degree[i];
+    }
+  }
+  return maxDegree;
+}
+
+static int orderLargestFirst(int n, const int* col_ptrs, const int* col_ids, const int* row_ptrs, int* order)
+{
+  int i, d, maxDegree;
+  int *degree = (int*) malloc(n * sizeof(int));
+  int *count;
+  if (!degree) {
+    return 1;
+  }
+  maxDegree = pathDegrees(n, col_ptrs, col_ids, row_ptrs, degree);
+  count = (int*) calloc(maxDegree+2, sizeof(int));
+  if (!count) {
+    free(degree);
+    return 1;
+  }
+  /* counting sort by decreasing degree, stable within equal degrees */
+  for (i = 0; i < n; ++i) {
+    count[maxDegree-degree[i]+1]++;
+  }
+  for (d = 1; d <= maxDegree+1; ++d) {
+    count[d] += count[d-1];
+  }
+  for (i = 0; i < n; ++i) {
+    order[count[maxDegree-degree[i]]++] = i;
+  }
+  free(count);
+  free(degree);
+  return 0;
+}
+
+static int orderSmallestLast(int n, const int* col_ptrs, const int* col_ids, const int* row_ptrs, const int* row_ids, int* order)
+{
+  BUCKETS b = {0};
+  int i, j, k, l, d = 0, pos;
+  int *degree = (int*) malloc(n * sizeof(int));
+  char *removed = (char*) calloc(n, 1);
+  if (!degree || !removed || allocBuckets(&b, n, pathDegrees(n, col_ptrs, col_ids, row_ptrs, degree))) {
+    free(degree);
+    free(removed);
+    freeBuckets(&b);
+    return 1;
+  }
+  for (i = n-1; i >= 0; --i) {
+    bucketInsert(&b, i, degree[i]);
+    if (degree[i] < d || i == n-1) {
+      d = degree[i];
+    }
+  }
+  /* the column removed first is colored last */
+  for (pos = n-1; pos >= 0; --pos) {
+    while (b.head[d] < 0) {
+      d++;
+    }
+    j = b.head[d];
+    bucketRemove(&b, j);
+    removed[j] = 1;
+    order[pos] = j;
+    for (k = col_ptrs[j]; k < col_ptrs[j+1]; ++k) {
+      for (l = row_ptrs[col_ids[k]]; l < row_ptrs[col_ids[k]+1]; ++l) {
+        i = row_ids[l];
+        if (!removed[i] && b.degree[i] > 0) {
+          bucketRemove(&b, i);
+          bucketInsert(&b, i, b.degree[i]-1);
+          if (b.degree[i] < d) {
+            d = b.degree[i];
+          }
+        }
+      }
+    }
+  }
+  free(degree);
+  free(removed);
+  freeBuckets(&b);
+  return 0;
+}
+
+static int orderIncidenceDegree(int n, const int* col_ptrs, const int* col_ids, const int* row_ptrs, const int* row_ids, int* order)
+{
+  BUCKETS b = {0};
+  int i, j, k, l, d = 0, pos, maxDegree = 0;
+  int *degree = (int*) malloc(n * sizeof(int));
+  char *ordered = (char*) calloc(n, 1);
+  if (!degree || !ordered || allocBuckets(&b, n, maxDegree = pathDegrees(n, col_ptrs, col_ids, row_ptrs, degree))) {
+    free(degree);
+    free(ordered);
+    freeBuckets(&b);
+    return 1;
+  }
+  for (i = n-1; i >= 0; --i) {
+    bucketInsert(&b, i, 0);
+  }
+  for (pos = 0; pos < n; ++pos) {
+    while (b.head[d] < 0) {
+      d--;
+    }
+    j = b.head[d];
+    bucketRemove(&b, j);
+    ordered[j] = 1;
+    order[pos] = j;
+    for (k = col_ptrs[j]; k < col_ptrs[j+1]; ++k) {
+      for (l = row_ptrs[col_ids[k]]; l < row_ptrs[col_ids[k]+1]; ++l) {
+        i = row_ids[l];
+        if (!ordered[i] && b.degree[i] < maxDegree) {
+          bucketRemove(&b, i);
+          bucketInsert(&b, i, b.degree[i]+1);
+          if (b.degree[i] > d) {
+            d = b.degree[i];
+          }
+        }
+      }
+    }
+  }
+  free(degree);
+  free(ordered);
+  freeBuckets(&b);
+  return 0;
+}
+
+int partialDistance2Coloring(int n, const int* col_ptrs, const int* col_ids,
+                             const int* row_ptrs, const int* row_ids, int ordering, int* color)
+{
+  int i, j, k, l, c, nColors = 0, fail = 0;
+  int *order, *forbidden;
+
+  if (n <= 0) {
+    return 0;
+  }
+  order = (int*) malloc(n * sizeof(int));
+  forbidden = (int*) malloc((n+1) * sizeof(int));
+  if (!order || !forbidden) {
+    free(order);
+    free(forbidden);
+    return -1;
+  }
+
+  switch (ordering) {
+  case COLORING_LARGEST_FIRST:
+    fail = orderLargestFirst(n, col_ptrs, col_ids, row_ptrs, order);
+    break;
+  case COLORING_SMALLEST_LAST:
+    fail = orderSmallestLast(n, col_ptrs, col_ids, row_ptrs, row_ids, order);
+    break;
+  case COLORING_INCIDENCE_DEGREE:
+    fail = orderIncidenceDegree(n, col_ptrs, col_ids, row_ptrs, row_ids, order);
+    break;
+  default:
+    for (i = 0; i < n; ++i) {
+      order[i] = i;
+    }
+  }
+  if (fail) {
+    free(order);
+    free(forbidden);
+    return -1;
+  }
+
+  memset(color, 0, n * sizeof(int));
+  memset(forbidden, -1, (n+1) * sizeof(int));
+  for (i = 0; i < n; ++i) {
+    j = order[i];
+    /* forbid the colors of all columns sharing a row with j */
+    for (k = col_ptrs[j]; k < col_ptrs[j+1]; ++k) {
+      for (l = row_ptrs[col_ids[k]]; l < row_ptrs[col_ids[k]+1]; ++l) {
+        forbidden[color[row_ids[l]]] = j;
+      }
+    }
+    for (c = 1; forbidden[c] == j; ++c);
+    color[j] = c;
+    if (c > nColors) {
+      nColors = c;
+    }
+  }
+
+  free(order);
+  free(forbidden);
+  return nColors;
+}
@@ -0,0 +1,63 @@
+/*
+ * This file is part of OpenModelica.
+ *
+ * Copyright (c) 1998-2010, Linköpings University,
+ * Department of Computer and Information Science,
+ * SE-58183 Linköping, Sweden.
+ *
+ * All rights reserved.
+ *
+ * THIS PROGRAM IS PROVIDED UNDER THE TERMS OF THIS OSMC PUBLIC
+ * LICENSE (OSMC-PL). ANY USE, REPRODUCTION OR DISTRIBUTION OF
+ * THIS PROGRAM CONSTITUTES RECIPIENT'S ACCEPTANCE OF THE OSMC
+ * PUBLIC LICENSE.
+ *
+ * The OpenModelica software and the Open Source Modelica
+ * Consortium (OSMC) Public License (OSMC-PL) are obtained
+ * from Linköpings University, either from the above address,
+ * from the URL: http://www.ida.liu.se/projects/OpenModelica
+ * and in the OpenModelica distribution.
+ *
+ * This program is distributed  WITHOUT ANY WARRANTY; without
+ * even the implied warranty of  MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE, EXCEPT AS EXPRESSLY SET FORTH
+ * IN THE BY RECIPIENT SELECTED SUBSIDIARY LICENSE CONDITIONS
+ * OF OSMC-PL.
+ *
+ * See the full OSMC Public License conditions for more details.
+ *
+ */
+
+/*
+ * file:        coloring.h
+ * description: Greedy partial distance-2 coloring of the columns of a sparse
+ *              pattern, used to compress the evaluation of sparse Jacobians.
+ *              The pattern is given twice in compressed form: by column
+ *              (col_ptrs/col_ids hold the rows of each column) and by row
+ *              (row_ptrs/row_ids hold the columns of each row).
+ *              All indexes are 0-based, colors are 1-based.
+ */
+
+#ifndef OMC_COLORING_H_
+#define OMC_COLORING_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define COLORING_NATURAL 0            /* columns in the given order */
+#define COLORING_LARGEST_FIRST 1      /* decreasing distance-2 degree */
+#define COLORING_SMALLEST_LAST 2      /* repeatedly remove the column with smallest degree */
+#define COLORING_INCIDENCE_DEGREE 3   /* most neighbours among the already ordered columns */
+
+/* Colors the n columns of the pattern using the given ordering heuristic.
+ * color must have room for n entries. Returns the number of colors used or
+ * -1 if memory could not be allocated. */
+int partialDistance2Coloring(int n, const int* col_ptrs, const int* col_ids,
+                             const int* row_ptrs, const int* row_ids, int ordering, int* color);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
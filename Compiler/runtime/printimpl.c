@@ -48,13 +48,13 @@ extern char* _replace(const char* source_str, const char* search_str, const char
 typedef struct print_members_s {
   char *buf;
   char *errorBuf;
-  int nfilled;
-  int cursize;
-  int errorNfilled;
-  int errorCursize;
+  size_t nfilled;
+  size_t cursize;
+  size_t errorNfilled;
+  size_t errorCursize;
   char** savedBuffers;
-  long* savedCurSize;
-  long* savedNfilled;
+  size_t* savedCurSize;
+  size_t* savedNfilled;
 } print_members;
 
 #include <pthread.h>
@@ -119,27 +119,26 @@ static print_members* getMembers(threadData_t *threadData)
 #define savedCurSize members->savedCurSize
 #define savedNfilled members->savedNfilled
 
-static int increase_buffer(threadData_t *threadData)
+/* Makes room for extra more characters and the terminating NUL in the buffer.
+ * The buffer grows geometrically in a single step, however long the string
+ * is, and realloc avoids copying it where the allocator can extend it. */
+static int reserve_buffer(print_members *members, size_t extra)
 {
-  print_members* members = getMembers(threadData);
   char *new_buf;
-  int new_size;
-  if (cursize == 0) {
-    new_buf = (char*)malloc(INITIAL_BUFSIZE*sizeof(char));
-    if (new_buf == NULL) { return -1; }
-    new_buf[0]='\0';
-    cursize = INITIAL_BUFSIZE;
-  } else {
-    //fprintf(stderr,"increasing buffer from %d to %d \n",cursize,((int)(cursize * GROWTH_FACTOR)));
-    new_buf = (char*)malloc((new_size =(int) (cursize * GROWTH_FACTOR))*sizeof(char));
-    if (new_buf == NULL) { return -1; }
-    memcpy(new_buf,buf,cursize);
-    cursize = new_size;
+  size_t new_size = cursize ? cursize : INITIAL_BUFSIZE;
+  if (buf != NULL && nfilled + extra + 1 <= cursize) {
+    return 0;
   }
-  if (buf) {
-    free(buf);
+  while (new_size < nfilled + extra + 1) {
+    new_size = (size_t) (new_size * GROWTH_FACTOR) + 1;
+  }
+  new_buf = (char*)realloc(buf, new_size*sizeof(char));
+  if (new_buf == NULL) { return -1; }
+  if (buf == NULL) {
+    new_buf[0] = '\0';
   }
   buf = new_buf;
+  cursize = new_size;
   return 0;
 }
 
@@ -147,7 +146,7 @@ static int increase_buffer_fixed(threadData_t *threadData,int increase)
 {
   print_members* members = getMembers(threadData);
   char * new_buf;
-  int new_size;
+  size_t new_size;
 
   if (cursize == 0) {
     new_buf = (char*)malloc(increase*sizeof(char));
@@ -155,7 +154,7 @@ static int increase_buffer_fixed(threadData_t *threadData,int increase)
     new_buf[0]='\0';
     cursize = increase;
   } else {
-  new_size = (int)(cursize+increase);
+  new_size = cursize+increase;
     //fprintf(stderr,"increasing buffer_FIXED_ from %d to %d \n",cursize,new_size);
     new_buf = (char*)malloc(new_size*sizeof(char));
     if (new_buf == NULL) { return -1; }
@@ -170,47 +169,42 @@ static int increase_buffer_fixed(threadData_t *threadData,int increase)
   return 0;
 }
 
-static int error_increase_buffer(threadData_t *threadData)
+/* The same as reserve_buffer, for the error buffer */
+static int reserve_error_buffer(print_members *members, size_t extra)
 {
-  print_members* members = getMembers(threadData);
-  char * new_buf;
-  int new_size;
-
-  if (errorCursize == 0) {
-    new_buf = (char*)malloc(INITIAL_BUFSIZE*sizeof(char));
-    if (new_buf == NULL) { return -1; }
-    new_buf[0]='\0';
-    errorCursize = INITIAL_BUFSIZE;
-  } else {
-    new_buf = (char*)malloc((new_size =(int) (errorCursize * GROWTH_FACTOR))*sizeof(char));
-    if (new_buf == NULL) { return -1; }
-    memcpy(new_buf,errorBuf,errorCursize);
-    errorCursize = new_size;
+  char *new_buf;
+  size_t new_size = errorCursize ? errorCursize : INITIAL_BUFSIZE;
+  if (errorBuf != NULL && errorNfilled + extra + 1 <= errorCursize) {
+    return 0;
   }
-  if (errorBuf) {
-    free(errorBuf);
+  while (new_size < errorNfilled + extra + 1) {
+    new_size = (size_t) (new_size * GROWTH_FACTOR) + 1;
+  }
+  new_buf = (char*)realloc(errorBuf, new_size*sizeof(char));
+  if (new_buf == NULL) { return -1; }
+  if (errorBuf == NULL) {
+    new_buf[0] = '\0';
   }
   errorBuf = new_buf;
+  errorCursize = new_size;
   return 0;
 }
 
 static int print_error_buf_impl(threadData_t *threadData,const char *str)
 {
   print_members* members = getMembers(threadData);
-  /*  printf("cursize: %d, nfilled %d, strlen: %d\n",cursize,nfilled,strlen(str));*/
+  size_t len;
 
   if (str == NULL) {
     return -1;
   }
-  while (errorNfilled + strlen(str)+1 > errorCursize) {
-    if (error_increase_buffer(threadData) != 0) {
-      return -1;
-    }
-    /* printf("increased -- cursize: %d, nfilled %d\n",cursize,nfilled);*/
+  len = strlen(str);
+  if (reserve_error_buffer(members, len) != 0) {
+    return -1;
   }
-
-  sprintf((char*)(errorBuf+strlen(errorBuf)),"%s",str);
-  errorNfilled=strlen(errorBuf);
+  memcpy(errorBuf+errorNfilled, str, len);
+  errorNfilled += len;
+  errorBuf[errorNfilled] = '\0';
   return 0;
 }
 
@@ -260,7 +254,7 @@ static const char* PrintImpl__getErrorString(threadData_t *threadData)
 {
   print_members* members = getMembers(threadData);
   if (errorBuf == 0) {
-    if(error_increase_buffer(threadData) != 0) {
+    if(reserve_error_buffer(members, 0) != 0) {
       return NULL;
     }
   }
@@ -271,14 +265,10 @@ static const char* PrintImpl__getErrorString(threadData_t *threadData)
 static int PrintImpl__printBuf(threadData_t *threadData,const char* str)
 {
   print_members* members = getMembers(threadData);
-  long len = strlen(str);
-  /* printf("cursize: %d, nfilled %d, strlen: %d\n",cursize,nfilled,strlen(str)); */
+  size_t len = strlen(str);
 
-  while (nfilled + len + 1 > cursize) {
-    if(increase_buffer(threadData)!= 0) {
-      return 1;
-    }
-    /* printf("increased -- cursize: %d, nfilled %d\n",cursize,nfilled); */
+  if (reserve_buffer(members, len) != 0) {
+    return 1;
   }
 
   /*
@@ -312,7 +302,7 @@ static const char* PrintImpl__getString(threadData_t *threadData)
     return "";
   }
   if (buf == 0) {
-    if (increase_buffer(threadData) != 0) {
+    if (reserve_buffer(members, 0) != 0) {
       return NULL;
     }
   }
@@ -374,6 +364,17 @@ static int PrintImpl__writeBuf(threadData_t *threadData,const char* filename)
 
 #include <regex.h>
 
+/* Only the lines written for modelicaLine and endModelicaLine start with a
+ * comment opened by '#'; checking that is much cheaper than running the
+ * regular expressions on every line. */
+static int is_line_directive(const char *str)
+{
+  while (*str == ' ') {
+    str++;
+  }
+  return str[0] == '/' && str[1] == '*' && str[2] == '#';
+}
+
 /* returns 0 on success */
 static int PrintImpl__writeBufConvertLines(threadData_t *threadData,const char *filename)
 {
@@ -384,6 +385,8 @@ static int PrintImpl__writeBufConvertLines(threadData_t *threadData,const char *
   const char *fileOpenMode = "wb";  /* on Unixes don't bother, do it binary mode */
 #endif
   char *str = buf, *next;
+  size_t len;
+  int directive;
   FILE * file = NULL;
   regex_t re_begin,re_end;
   regmatch_t matches[3];
@@ -433,6 +436,7 @@ static int PrintImpl__writeBufConvertLines(threadData_t *threadData,const char *
     regfree(&re_end);
     return 1;
   }
+  setvbuf(file, NULL, _IOFBF, 65536);
   if (str == NULL || str[0]=='\0') {
     /* nothing to write to file, just close it and return ! */
     fclose(file);
@@ -456,11 +460,13 @@ static int PrintImpl__writeBufConvertLines(threadData_t *threadData,const char *
   do {
     next = strchr(str,'\n');
     if (!next) {
-      fprintf(file,"%s",str);
+      fputs(str,file);
       break;
     }
+    len = next - str;
     *next++ = '\0';
-    if (0==regexec(&re_begin, str, 3, matches, 0)) {
+    directive = is_line_directive(str);
+    if (directive && 0==regexec(&re_begin, str, 3, matches, 0)) {
       str[matches[1].rm_eo] = '\0';
       str[matches[2].rm_eo] = '\0';
       modelicaFileName = str + matches[1].rm_so;
@@ -469,7 +475,7 @@ static int PrintImpl__writeBufConvertLines(threadData_t *threadData,const char *
       /* on Windows change the backslashes to forward slashes */
       modelicaFileName = _replace(modelicaFileName, "\\", "/");
 #endif
-    } else if (0==regexec(&re_end, str, 3, matches, 0)) {
+    } else if (directive && 0==regexec(&re_end, str, 3, matches, 0)) {
       if (modelicaFileName) { /* There is sometimes #endModlicaLine without a matching #modelicaLine */
 #if defined(__MINGW32__) || defined(_MSC_VER)
         GC_free(modelicaFileName);
@@ -479,10 +485,12 @@ static int PrintImpl__writeBufConvertLines(threadData_t *threadData,const char *
       }
     } else if (modelicaFileName) {
       fprintf(file,"#line %ld \"%s\"\n", modelicaLine, modelicaFileName);
-      fprintf(file,"%s\n", str);
+      fwrite(str,1,len,file);
+      fputc('\n',file);
       nlines+=2;
     } else {
-      fprintf(file,"%s\n", str);
+      fwrite(str,1,len,file);
+      fputc('\n',file);
       nlines++;
     }
     str = next;
@@ -504,7 +512,7 @@ static int PrintImpl__writeBufConvertLines(threadData_t *threadData,const char *
 static long PrintImpl__getBufLength(threadData_t *threadData)
 {
   print_members* members = getMembers(threadData);
-  return nfilled;
+  return (long) nfilled;
 }
 
 /* returns 0 on success */
@@ -512,13 +520,11 @@ static int PrintImpl__printBufSpace(threadData_t *threadData,long nSpaces)
 {
   print_members* members = getMembers(threadData);
   if (nSpaces > 0) {
-   while (nfilled + nSpaces + 1 > cursize) {
-     if(increase_buffer(threadData)!= 0) {
-       return 1;
-     }
+   if (reserve_buffer(members, (size_t)nSpaces) != 0) {
+     return 1;
    }
    memset(buf+nfilled,' ',(size_t)nSpaces);
-   nfilled += nSpaces;
+   nfilled += (size_t)nSpaces;
    buf[nfilled] = '\0';
   }
   return 0;
@@ -528,10 +534,8 @@ static int PrintImpl__printBufSpace(threadData_t *threadData,long nSpaces)
 static int PrintImpl__printBufNewLine(threadData_t *threadData)
 {
   print_members* members = getMembers(threadData);
-  while (nfilled + 1+1 > cursize) {
-    if(increase_buffer(threadData)!= 0) {
-      return 1;
-    }
+  if (reserve_buffer(members, 1) != 0) {
+    return 1;
   }
   buf[nfilled++] = '\n';
   buf[nfilled] = '\0';
@@ -572,7 +576,7 @@ static long PrintImpl__saveAndClearBuf(threadData_t *threadData)
   print_members* members = getMembers(threadData);
   long freeHandle,foundHandle=0;
   if (!buf) {
-    increase_buffer(threadData);
+    reserve_buffer(members, 0);
   }
   if (! savedBuffers) {
     savedBuffers = (char**)calloc(MAXSAVEDBUFFERS,sizeof(char*));
@@ -582,14 +586,14 @@ static long PrintImpl__saveAndClearBuf(threadData_t *threadData)
     }
   }
   if (! savedCurSize) {
-    savedCurSize = (long*)calloc(MAXSAVEDBUFFERS,sizeof(long));
+    savedCurSize = (size_t*)calloc(MAXSAVEDBUFFERS,sizeof(size_t));
     if (!savedCurSize) {
       fprintf(stderr, "Internal error allocating savedCurSize in Print.saveAndClearBuf\n");
       return -1;
     }
   }
   if (! savedNfilled) {
-    savedNfilled = (long*)calloc(MAXSAVEDBUFFERS,sizeof(long));
+    savedNfilled = (size_t*)calloc(MAXSAVEDBUFFERS,sizeof(size_t));
     if (!savedNfilled) {
       fprintf(stderr, "Internal error allocating savedNfilled in Print.saveAndClearBuf\n");
       return -1;
@@ -607,7 +611,7 @@ static long PrintImpl__saveAndClearBuf(threadData_t *threadData)
     return -1;
   }
   if (!buf) {
-    increase_buffer(threadData); /* Initialize it; the saved buffers cannot handle NULL */
+    reserve_buffer(members, 0); /* Initialize it; the saved buffers cannot handle NULL */
   }
   savedBuffers[freeHandle] = buf;
   savedCurSize[freeHandle] = cursize;
@@ -89,6 +89,30 @@ static int serversocket;
 static unsigned fromlen;
 static struct sockaddr_in clientAddr;
 
+/* The server accepts several clients; each request is answered on the socket
+ * it was received from. */
+#define MAX_CLIENTS 64
+static int clients[MAX_CLIENTS];
+static int nclients = 0;
+
+#if defined(MSG_NOSIGNAL)
+#define SEND_FLAGS MSG_NOSIGNAL
+#else
+#define SEND_FLAGS 0
+#endif
+
+static void removeClient(int sock)
+{
+  int i;
+  for (i=0; i<nclients; i++) {
+    if (clients[i] == sock) {
+      clients[i] = clients[--nclients];
+      close(sock);
+      return;
+    }
+  }
+}
+
 static int
 make_socket (unsigned short int port)
 {
@@ -146,6 +170,7 @@ extern int Socket_waitforconnect(int port)
     c_add_message(NULL,-1,ErrorType_scripting,ErrorLevel_error,"accept failed: %s",tokens,1);
     return -1;
   }
+  clients[nclients++] = ns;
   return ns;
 }
 
@@ -163,6 +188,9 @@ extern char* SocketImpl_handlerequest(int sock)
     return NULL;
   }
   len = recv(sock,buf,bufSize,0);
+  if (len < 0) {
+    len = 0;
+  }
   FD_ZERO(&sockSet);
   FD_SET(sock,&sockSet); // create fd set of
   if (len == bufSize) { // If we filled the buffer, check for more
@@ -185,9 +213,67 @@ extern char* SocketImpl_handlerequest(int sock)
   return buf;
 }
 
+/* Waits until a connected client sends a request, accepting new clients in
+ * the meantime, and reads the requests of all clients that have sent one.
+ * Clients that closed the connection are dropped. Returns the number of
+ * requests stored in socks and reqs (to be freed by the caller), or -1 on
+ * error. */
+extern int SocketImpl_handlerequests(int *socks, char **reqs, int maxRequests)
+{
+  int i, ns, maxfd, nreq = 0;
+  fd_set readSet;
+  while (nreq == 0) {
+    FD_ZERO(&readSet);
+    FD_SET(serversocket,&readSet);
+    maxfd = serversocket;
+    for (i=0; i<nclients; i++) {
+      FD_SET(clients[i],&readSet);
+      maxfd = clients[i] > maxfd ? clients[i] : maxfd;
+    }
+    if (select(maxfd+1,&readSet,NULL,NULL,NULL) < 0) {
+      const char *tokens[1] = {strerror(errno)};
+      if (errno == EINTR) {
+        continue;
+      }
+      c_add_message(NULL,-1,ErrorType_scripting,ErrorLevel_error,"select failed: %s",tokens,1);
+      return -1;
+    }
+    for (i=0; i<nclients && nreq<maxRequests; ) {
+      int sock = clients[i];
+      if (FD_ISSET(sock,&readSet)) {
+        char *buf = SocketImpl_handlerequest(sock);
+        if (buf == NULL) {
+          return -1;
+        }
+        if (*buf == 0) { /* the client closed the connection */
+          free(buf);
+          removeClient(sock);
+          continue;
+        }
+        socks[nreq] = sock;
+        reqs[nreq++] = buf;
+      }
+      i++;
+    }
+    if (FD_ISSET(serversocket,&readSet) && nclients < MAX_CLIENTS) {
+      ns = accept(serversocket,(struct sockaddr *)&clientAddr,&fromlen);
+      if (ns >= 0) {
+        clients[nclients++] = ns;
+      }
+    }
+  }
+  return nreq;
+}
+
 extern void Socket_close(int sock)
 {
-  int clerr;
+  int i, clerr;
+  for (i=0; i<nclients; i++) {
+    if (clients[i] == sock) {
+      clients[i] = clients[--nclients];
+      break;
+    }
+  }
   clerr=close(sock);
   if (clerr < 0) {
     perror("Socket close:");
@@ -197,9 +283,11 @@ extern void Socket_close(int sock)
 
 extern void Socket_sendreply(int sock, const char* string)
 {
-  if(send(sock,string,strlen(string)+1,0)<0) {
+  if(send(sock,string,strlen(string)+1,SEND_FLAGS)<0) {
+    /* the client went away; the other clients are still served */
     perror("sendreply:");
-    exit(1);
+    removeClient(sock);
+    return;
   }
   fsync(sock);
 }
@@ -207,6 +295,9 @@ extern void Socket_sendreply(int sock, const char* string)
 extern void Socket_cleanup()
 {
   int clerr;
+  while (nclients > 0) {
+    removeClient(clients[0]);
+  }
   if ((clerr=close(serversocket))< 0 ) {
     perror("close:");
   }
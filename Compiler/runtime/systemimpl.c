@@ -169,11 +169,6 @@ static char *linker = (char *)def_linker;
 static char *cflags = (char *)def_cflags;
 static char *ldflags= (char *)def_ldflags;
 
-static int hasExpandableConnectors = 0;
-static int hasInnerOuterDefinitions = 0;
-static int hasStreamConnectors = 0;
-static int isPartialInstantiation = 0;
-static int usesCardinality = 1;
 static char* class_names_for_simulation = NULL;
 static const char *select_from_dir = NULL;
 
@@ -2093,6 +2088,12 @@ int System_getLoadModelPath(const char *name, void *prios, void *mps, int exactV
 typedef struct systemMoData {
   int tmp_tick_no[MAX_TMP_TICK];
   int tmp_tick_max_no[MAX_TMP_TICK];
+  /* Instantiation state; per thread since the server evaluates queries in parallel */
+  int hasExpandableConnectors;
+  int hasInnerOuterDefinitions;
+  int hasStreamConnectors;
+  int isPartialInstantiation;
+  int usesCardinality;
 } systemMoData;
 
 pthread_once_t system_once_create_key = PTHREAD_ONCE_INIT;
@@ -2121,6 +2122,7 @@ static systemMoData* getSystemMoData(threadData_t *threadData)
   if (res != NULL) return res;
   /* We use malloc instead of new because when we do dynamic loading of functions, C++ objects in TLS might be free'd upon return to the main process. */
   res = (systemMoData*) calloc(1,sizeof(systemMoData));
+  res->usesCardinality = 1;
   pthread_setspecific(systemMoKey,res);
   if (threadData) {
     /* Still use pthreads API to free the buffer on thread exit even though we pass this thing around
@@ -2794,6 +2796,39 @@ int SystemImpl__rename(const char *source, const char *dest)
   return 0==rename(source,dest);
 }
 
+/* returns 1 on success */
+int SystemImpl__copyFile(const char *source, const char *dest)
+{
+  char buf[8192];
+  FILE *in,*out;
+  size_t n;
+  int error=0;
+  in = fopen(source,"rb");
+  if (in == NULL) {
+    return 0;
+  }
+  out = fopen(dest,"wb");
+  if (out == NULL) {
+    fclose(in);
+    return 0;
+  }
+  while ((n = fread(buf,1,8192,in)) > 0) {
+    if (fwrite(buf,1,n,out) != n) {
+      error = 1;
+      break;
+    }
+  }
+  error = error || ferror(in);
+  fclose(in);
+  if (fclose(out)) {
+    error = 1;
+  }
+  if (error) {
+    SystemImpl__removeFile(dest);
+  }
+  return !error;
+}
+
 char* SystemImpl__ctime(double time)
 {
   char buf[64] = {0}; /* needs to be >=26 char */
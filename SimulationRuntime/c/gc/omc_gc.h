@@ -121,10 +121,17 @@ typedef struct threadData_s {
  * currentJumpStage:
  *   define which simulation jump buffer
  *   is currently used.
+ *
+ * solveContinuous, noThrowDivZero:
+ *   solver state of the algebraic system that is
+ *   currently solved by this thread; kept per thread
+ *   so independent systems can be solved concurrently.
  */
   jmp_buf *globalJumpBuffer;
   jmp_buf *simulationJumpBuffer;
   errorStage currentErrorStage;
+  int solveContinuous;    /* =1 while solving a continuous system to avoid zero-crossings jumps, 0 otherwise */
+  int noThrowDivZero;     /* =1 while solving an algebraic system to avoid THROW for division by zero, 0 otherwise */
   struct threadData_s *parent;
   pthread_mutex_t parentMutex; /* Prevent children from all manipulating the parent at the same time */
   void *plotClassPointer;
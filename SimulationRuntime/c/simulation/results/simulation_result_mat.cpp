@@ -32,6 +32,7 @@
 #include "util/rtclock.h"
 #include "simulation/options.h"
 #include "simulation_result_mat.h"
+#include "util/write_matlab4.h"
 
 #include <fstream>
 #include <iostream>
@@ -65,6 +66,9 @@ typedef struct mat_data {
 
   unsigned int negatedboolaliases;
   int numVars;
+
+  FILE *sensFp;          /* separate file for the sensitivities, see -idaSensitivityFile */
+  long sensData2HdrPos;  /* position of data_2 matrix's header in the sensitivity file */
 } mat_data;
 
 static long flattenStrBuf(int dims, const struct VAR_INFO** src, char* &dest, int& longest, int& nstrings, bool fixNames, bool useComment);
@@ -74,6 +78,8 @@ static void generateDataInfo(simulation_result *self,DATA *data, threadData_t *t
 static void generateData_1(DATA *data, threadData_t *threadData, double* &data_1, int& rows, int& cols, double tstart, double tstop);
 
 static int calcDataSize(simulation_result *self,DATA *data);
+static int resultFileSensitivities(DATA *data);
+static void initSensitivityFile(mat_data *matData, DATA *data, threadData_t *threadData);
 static const VAR_INFO** calcDataNames(simulation_result *self,DATA *data,int dataSize);
 
 static const struct VAR_INFO timeValName = {0,-1,"time","Simulation time [s]",{"",-1,-1,-1,-1}};
@@ -101,10 +107,7 @@ static int calcDataSize(simulation_result *self,DATA *data)
     }
 
   /* put sensitivity analysis also to the result file */
-  if (omc_flag[FLAG_IDAS])
-  {
-    sz += (data->modelData->nSensitivityVars-data->modelData->nSensitivityParamVars);
-  }
+  sz += resultFileSensitivities(data);
 
   for(int i = 0; i < modelData->nVariablesInteger; i++)
     if(!modelData->integerVarsData[i].filterOutput)
@@ -153,7 +156,7 @@ static const VAR_INFO** calcDataNames(simulation_result *self,DATA *data,int dat
     names[curVar++] = &(modelData->realVarsData[i].info);
 
   /* put sensitivity analysis also to the result file */
-  if (omc_flag[FLAG_IDAS])
+  if (resultFileSensitivities(data))
   {
     for(int i = data->modelData->nSensitivityParamVars; i < data->modelData->nSensitivityVars; i++)
     {
@@ -232,7 +235,7 @@ void mat4_init(simulation_result *self,DATA *data, threadData_t *threadData)
   int rows, cols;
   int32_t *intMatrix = NULL;
   double *doubleMatrix = NULL;
-  int nSensitivities = omc_flag[FLAG_IDAS] ? mData->nSensitivityVars-data->modelData->nSensitivityParamVars: 0;
+  int nSensitivities = resultFileSensitivities(data);
   assert(sizeof(char) == 1);
   rt_tick(SIM_TIMER_OUTPUT);
   matData->numVars = calcDataSize(self,data);
@@ -242,6 +245,7 @@ void mat4_init(simulation_result *self,DATA *data, threadData_t *threadData)
   matData->ntimepoints = 0;
   matData->startTime = data->simulationInfo->startTime;
   matData->stopTime = data->simulationInfo->stopTime;
+  matData->sensFp = NULL;
 
   try {
     /* open file */
@@ -289,6 +293,11 @@ void mat4_init(simulation_result *self,DATA *data, threadData_t *threadData)
     intMatrix = NULL;
     matData->fp.flush();
 
+    if (omc_flag[FLAG_IDAS] && omc_flag[FLAG_IDAS_FILE])
+    {
+      initSensitivityFile(matData, data, threadData);
+    }
+
   }
   catch(...)
   {
@@ -307,7 +316,7 @@ void mat4_init(simulation_result *self,DATA *data, threadData_t *threadData)
 void mat4_free(simulation_result *self,DATA *data, threadData_t *threadData)
 {
   mat_data *matData = (mat_data*) self->storage;
-  int nSensitivities = omc_flag[FLAG_IDAS] ? data->modelData->nSensitivityVars - data->modelData->nSensitivityParamVars : 0;
+  int nSensitivities = resultFileSensitivities(data);
   rt_tick(SIM_TIMER_OUTPUT);
   /* this is a bad programming practice - closing file in destructor,
    * where a proper error reporting can't be done
@@ -326,6 +335,13 @@ void mat4_free(simulation_result *self,DATA *data, threadData_t *threadData)
       /* just ignore, we are in destructor */
     }
   }
+  if(matData->sensFp)
+  {
+    fseek(matData->sensFp, matData->sensData2HdrPos, SEEK_SET);
+    writeMatVer4FloatMatrixHeader(matData->sensFp, "data_2", data->modelData->nSensitivityVars - data->modelData->nSensitivityParamVars + 1 /* add one more for timeValue*/, matData->ntimepoints);
+    fclose(matData->sensFp);
+    matData->sensFp = NULL;
+  }
   delete matData;
   self->storage = NULL;
   rt_accumulate(SIM_TIMER_OUTPUT);
@@ -356,10 +372,22 @@ void mat4_emit(simulation_result *self,DATA *data, threadData_t *threadData)
     matData->fp.write((char*)&(data->localData[0]->realVars[i]),sizeof(double));
 
   /* put parameter sensitivity analysis also to the result file */
-  if (omc_flag[FLAG_IDAS])
+  for(int i = 0; i < resultFileSensitivities(data); i++)
+    matData->fp.write((char*)&(data->simulationInfo->sensitivityMatrix[i]),sizeof(double));
+
+  /* or to the separate sensitivity file in single precision */
+  if(matData->sensFp)
   {
+    float sensPoint = (float) data->localData[0]->timeValue;
+    bool ok = 1 == fwrite(&sensPoint, sizeof(float), 1, matData->sensFp);
     for(int i = 0; i < data->modelData->nSensitivityVars-data->modelData->nSensitivityParamVars; i++)
-      matData->fp.write((char*)&(data->simulationInfo->sensitivityMatrix[i]),sizeof(double));
+    {
+      sensPoint = (float) data->simulationInfo->sensitivityMatrix[i];
+      ok = ok && 1 == fwrite(&sensPoint, sizeof(float), 1, matData->sensFp);
+    }
+    if (!ok) {
+      throwStreamPrint(threadData, "Error while writing file %s", omc_flagValue[FLAG_IDAS_FILE]);
+    }
   }
   for(int i = 0; i < data->modelData->nVariablesInteger; i++) if(!data->modelData->integerVarsData[i].filterOutput)
     {
@@ -386,6 +414,66 @@ void mat4_emit(simulation_result *self,DATA *data, threadData_t *threadData)
   rt_accumulate(SIM_TIMER_OUTPUT);
 }
 
+/* number of sensitivities stored in the result file itself */
+static int resultFileSensitivities(DATA *data)
+{
+  if (omc_flag[FLAG_IDAS] && !omc_flag[FLAG_IDAS_FILE])
+    return data->modelData->nSensitivityVars - data->modelData->nSensitivityParamVars;
+  return 0;
+}
+
+/* The sensitivities can get large (one column per state and parameter), so
+ * with -idaSensitivityFile they are written to a separate mat file in single
+ * precision, containing only time and the sensitivities. */
+static void initSensitivityFile(mat_data *matData, DATA *data, threadData_t *threadData)
+{
+  const char Aclass[] = "A1 bt. ir1 na  Tj  re  ac  nt  so   r   y   ";
+  const char *filename = omc_flagValue[FLAG_IDAS_FILE];
+  const int nSens = data->modelData->nSensitivityVars - data->modelData->nSensitivityParamVars;
+  const struct VAR_INFO** names = (const VAR_INFO**) malloc((nSens+1)*sizeof(struct VAR_INFO*));
+  int32_t *dataInfo = (int32_t*) malloc(4*(nSens+1)*sizeof(int32_t));
+  const float data_1[2] = {(float) matData->startTime, (float) matData->stopTime};
+  char *stringMatrix = NULL;
+  int rows, cols;
+  bool ok;
+
+  assertStreamPrint(threadData, 0!=names && 0!=dataInfo, "Cannot alloc memory");
+  for(int i = 0; i <= nSens; i++)
+  {
+    names[i] = (i == 0) ? &timeValName : &(data->modelData->realSensitivityData[data->modelData->nSensitivityParamVars+i-1].info);
+    /* all variables are in data_2, time has index 1 */
+    dataInfo[4*i] = 2;
+    dataInfo[4*i+1] = i+1;
+    dataInfo[4*i+2] = 0;
+    dataInfo[4*i+3] = -1;
+  }
+
+  matData->sensFp = fopen(filename, "wb");
+  if(!matData->sensFp) {
+    free(names);
+    free(dataInfo);
+    throwStreamPrint(threadData, "Cannot open File %s for writing", filename);
+  }
+
+  ok = 0 == writeMatVer4Matrix(matData->sensFp, "Aclass", 4, 11, Aclass, sizeof(int8_t));
+  flattenStrBuf(nSens+1, names, stringMatrix, rows, cols, false, false);
+  ok = ok && 0 == writeMatVer4Matrix(matData->sensFp, "name", rows, cols, stringMatrix, sizeof(int8_t));
+  free(stringMatrix); stringMatrix = NULL;
+  flattenStrBuf(nSens+1, names, stringMatrix, rows, cols, false, true);
+  ok = ok && 0 == writeMatVer4Matrix(matData->sensFp, "description", rows, cols, stringMatrix, sizeof(int8_t));
+  free(stringMatrix); stringMatrix = NULL;
+  ok = ok && 0 == writeMatVer4Matrix(matData->sensFp, "dataInfo", 4, nSens+1, dataInfo, sizeof(int32_t));
+  ok = ok && 0 == writeMatVer4FloatMatrixHeader(matData->sensFp, "data_1", 1, 2);
+  ok = ok && 1 == fwrite(data_1, sizeof(data_1), 1, matData->sensFp);
+  matData->sensData2HdrPos = ftell(matData->sensFp);
+  ok = ok && 0 == writeMatVer4FloatMatrixHeader(matData->sensFp, "data_2", nSens+1, 0);
+  free(names);
+  free(dataInfo);
+  if(!ok) {
+    throwStreamPrint(threadData, "Cannot write to file %s", filename);
+  }
+}
+
 /* from an array of string creates flatten 'char*'-array suitable to be
    stored as MAT-file matrix */
 static inline void fixDerInName(char *str, size_t len)
@@ -491,7 +579,7 @@ void generateDataInfo(simulation_result *self, DATA *data, threadData_t *threadD
 {
   mat_data *matData = (mat_data*) self->storage;
   const MODEL_DATA *mdl_data = data->modelData;
-  int nSensitivities = omc_flag[FLAG_IDAS] ? mdl_data->nSensitivityVars - data->modelData->nSensitivityParamVars : 0;
+  int nSensitivities = resultFileSensitivities(data);
 
   /* size_t nVars = mdl_data->nStates*2+mdl_data->nAlgebraic;
     rows = 1+nVars+mdl_data->nParameters+mdl_data->nVarsAliases; */
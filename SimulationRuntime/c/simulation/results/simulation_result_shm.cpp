@@ -0,0 +1,329 @@
+/*
+ * This file is part of OpenModelica.
+ *
+ * Copyright (c) 1998-CurrentYear, Open Source Modelica Consortium (OSMC),
+ * c/o Linköpings universitet, Department of Computer and Information Science,
+ * SE-58183 Linköping, Sweden.
+ *
+ * All rights reserved.
+ *
+ * THIS PROGRAM IS PROVIDED UNDER THE TERMS OF THE BSD NEW LICENSE OR THE
+ * GPL VERSION 3 LICENSE OR THE OSMC PUBLIC LICENSE (OSMC-PL) VERSION 1.2.
+ * ANY USE, REPRODUCTION OR DISTRIBUTION OF THIS PROGRAM CONSTITUTES
+ * RECIPIENT'S ACCEPTANCE OF THE OSMC PUBLIC LICENSE OR THE GPL VERSION 3,
+ * ACCORDING TO RECIPIENTS CHOICE.
+ *
+ * The OpenModelica software and the OSMC (Open Source Modelica Consortium)
+ * Public License (OSMC-PL) are obtained from OSMC, either from the above
+ * address, from the URLs: http://www.openmodelica.org or
+ * http://www.ida.liu.se/projects/OpenModelica, and in the OpenModelica
+ * distribution. GNU version 3 is obtained from:
+ * http://www.gnu.org/copyleft/gpl.html. The New BSD License is obtained from:
+ * http://www.opensource.org/licenses/BSD-3-Clause.
+ *
+ * This program is distributed WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE, EXCEPT AS
+ * EXPRESSLY SET FORTH IN THE BY RECIPIENT SELECTED SUBSIDIARY LICENSE
+ * CONDITIONS OF OSMC-PL.
+ *
+ */
+
+/* Publishes results into a POSIX shared-memory ring buffer, see simulation_result_shm.h */
+
+#include "util/omc_error.h"
+#include "simulation_result_shm.h"
+#include "util/rtclock.h"
+
+#include <string.h>
+#include <ctype.h>
+#include <errno.h>
+
+#if !defined(__MINGW32__) && !defined(_MSC_VER)
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+extern "C" {
+
+typedef struct shm_storage {
+  int fd;
+  size_t size;
+  shm_result_header *header;
+  double *rows;
+} shm_storage;
+
+/* The segment name is derived from the result file name, so every
+ * simulation of a model publishes to the same, predictable segment. */
+void shm_result_segment_name(const char *filename, char *name, size_t size)
+{
+  const char *base = strrchr(filename, '/');
+  size_t i;
+
+  base = base ? base+1 : filename;
+  if (size < 2) {
+    if (size) name[0] = '\0';
+    return;
+  }
+  name[0] = '/';
+  for (i=1; i<size-1 && base[i-1]; i++) {
+    name[i] = isalnum((unsigned char)base[i-1]) ? base[i-1] : '_';
+  }
+  name[i] = '\0';
+}
+
+#if !defined(__MINGW32__) && !defined(_MSC_VER)
+
+void shm_init(simulation_result *self,DATA *data, threadData_t *threadData)
+{
+  MODEL_DATA *modelData = data->modelData;
+  shm_storage *storage = new shm_storage();
+  shm_result_header *header;
+  char name[256];
+  size_t namesLength = strlen("time") + 1;
+  uint32_t nReal = 0, nInteger = 0, nBoolean = 0;
+  uint64_t rowsOffset;
+  char *names;
+  long i;
+
+  self->storage = (void *)storage;
+
+  for (i=0; i<modelData->nVariablesReal; i++) if (!modelData->realVarsData[i].filterOutput) {
+    nReal++;
+    namesLength += strlen(modelData->realVarsData[i].info.name) + 1;
+  }
+  for (i=0; i<modelData->nVariablesInteger; i++) if (!modelData->integerVarsData[i].filterOutput) {
+    nInteger++;
+    namesLength += strlen(modelData->integerVarsData[i].info.name) + 1;
+  }
+  for (i=0; i<modelData->nVariablesBoolean; i++) if (!modelData->booleanVarsData[i].filterOutput) {
+    nBoolean++;
+    namesLength += strlen(modelData->booleanVarsData[i].info.name) + 1;
+  }
+
+  /* rows are aligned to a double */
+  rowsOffset = sizeof(shm_result_header) + namesLength;
+  rowsOffset = (rowsOffset + sizeof(double) - 1) / sizeof(double) * sizeof(double);
+  storage->size = rowsOffset + (size_t)SHM_RESULT_ROWS * (1+nReal+nInteger+nBoolean) * sizeof(double);
+
+  shm_result_segment_name(self->filename, name, sizeof(name));
+  /* never resize a segment that readers of an earlier run may still map */
+  shm_unlink(name);
+  storage->fd = shm_open(name, O_CREAT | O_EXCL | O_RDWR, 0644);
+  if (storage->fd < 0) {
+    throwStreamPrint(threadData, "Cannot create shared memory segment %s: %s", name, strerror(errno));
+  }
+  if (ftruncate(storage->fd, storage->size) != 0) {
+    close(storage->fd);
+    shm_unlink(name);
+    throwStreamPrint(threadData, "Cannot resize shared memory segment %s: %s", name, strerror(errno));
+  }
+  header = (shm_result_header*) mmap(NULL, storage->size, PROT_READ | PROT_WRITE, MAP_SHARED, storage->fd, 0);
+  if (header == MAP_FAILED) {
+    close(storage->fd);
+    shm_unlink(name);
+    throwStreamPrint(threadData, "Cannot map shared memory segment %s: %s", name, strerror(errno));
+  }
+  storage->header = header;
+  storage->rows = (double*) ((char*)header + rowsOffset);
+
+  header->nColumns = 1+nReal+nInteger+nBoolean;
+  header->nReal = nReal;
+  header->nInteger = nInteger;
+  header->nBoolean = nBoolean;
+  header->nRows = SHM_RESULT_ROWS;
+  header->namesOffset = sizeof(shm_result_header);
+  header->rowsOffset = rowsOffset;
+  header->rowsWritten = 0;
+  header->finished = 0;
+
+  names = (char*)header + header->namesOffset;
+  strcpy(names, "time");
+  names += strlen(names) + 1;
+  for (i=0; i<modelData->nVariablesReal; i++) if (!modelData->realVarsData[i].filterOutput) {
+    strcpy(names, modelData->realVarsData[i].info.name);
+    names += strlen(names) + 1;
+  }
+  for (i=0; i<modelData->nVariablesInteger; i++) if (!modelData->integerVarsData[i].filterOutput) {
+    strcpy(names, modelData->integerVarsData[i].info.name);
+    names += strlen(names) + 1;
+  }
+  for (i=0; i<modelData->nVariablesBoolean; i++) if (!modelData->booleanVarsData[i].filterOutput) {
+    strcpy(names, modelData->booleanVarsData[i].info.name);
+    names += strlen(names) + 1;
+  }
+
+  /* the magic marks the header as complete */
+  __sync_synchronize();
+  memcpy(header->magic, SHM_RESULT_MAGIC, sizeof(header->magic));
+
+  infoStreamPrint(LOG_SOLVER, 0, "Publishing results to shared memory segment %s", name);
+  rt_accumulate(SIM_TIMER_OUTPUT);
+}
+
+void shm_emit(simulation_result *self,DATA *data, threadData_t *threadData)
+{
+  shm_storage *storage = (shm_storage*) self->storage;
+  shm_result_header *header = storage->header;
+  MODEL_DATA *modelData = data->modelData;
+  SIMULATION_DATA *sData = data->localData[0];
+  double *row;
+  long i;
+
+  rt_tick(SIM_TIMER_OUTPUT);
+
+  row = storage->rows + (header->rowsWritten % header->nRows) * header->nColumns;
+  *row++ = sData->timeValue;
+  for (i=0; i<modelData->nVariablesReal; i++) if (!modelData->realVarsData[i].filterOutput)
+    *row++ = sData->realVars[i];
+  for (i=0; i<modelData->nVariablesInteger; i++) if (!modelData->integerVarsData[i].filterOutput)
+    *row++ = (double) sData->integerVars[i];
+  for (i=0; i<modelData->nVariablesBoolean; i++) if (!modelData->booleanVarsData[i].filterOutput)
+    *row++ = sData->booleanVars[i] ? 1.0 : 0.0;
+
+  /* publish the row */
+  __sync_synchronize();
+  __sync_fetch_and_add(&header->rowsWritten, 1);
+
+  rt_accumulate(SIM_TIMER_OUTPUT);
+}
+
+/* The segment is not unlinked, so readers can still fetch the last rows
+ * after the simulation terminated. The next run replaces it. */
+void shm_free(simulation_result *self,DATA *data, threadData_t *threadData)
+{
+  shm_storage *storage = (shm_storage*) self->storage;
+
+  rt_tick(SIM_TIMER_OUTPUT);
+  __sync_synchronize();
+  storage->header->finished = 1;
+  munmap(storage->header, storage->size);
+  close(storage->fd);
+  delete storage;
+  self->storage = NULL;
+  rt_accumulate(SIM_TIMER_OUTPUT);
+}
+
+/*! \fn shm_result_reader_open
+ *
+ *  Maps the segment of a (running) simulation read-only.
+ *
+ *  \return 0 on success, 1 if the segment does not exist or is not (yet) valid
+ */
+int shm_result_reader_open(shm_result_reader *reader, const char *name)
+{
+  struct stat st;
+
+  reader->header = NULL;
+  reader->fd = shm_open(name, O_RDONLY, 0);
+  if (reader->fd < 0) {
+    return 1;
+  }
+  if (fstat(reader->fd, &st) != 0 || (size_t)st.st_size < sizeof(shm_result_header)) {
+    close(reader->fd);
+    return 1;
+  }
+  reader->size = st.st_size;
+  reader->header = (shm_result_header*) mmap(NULL, reader->size, PROT_READ, MAP_SHARED, reader->fd, 0);
+  if (reader->header == MAP_FAILED) {
+    reader->header = NULL;
+    close(reader->fd);
+    return 1;
+  }
+  if (memcmp(reader->header->magic, SHM_RESULT_MAGIC, sizeof(reader->header->magic))) {
+    shm_result_reader_close(reader);
+    return 1;
+  }
+  __sync_synchronize();
+  return 0;
+}
+
+const char* shm_result_reader_column_name(const shm_result_reader *reader, uint32_t column)
+{
+  const char *name = (const char*)reader->header + reader->header->namesOffset;
+
+  if (column >= reader->header->nColumns) {
+    return NULL;
+  }
+  while (column--) {
+    name += strlen(name) + 1;
+  }
+  return name;
+}
+
+/*! \fn shm_result_reader_read_row
+ *
+ *  Copies row number row (counted from the start of the simulation)
+ *  into values, which has to hold nColumns doubles.
+ *
+ *  \return 0 on success, 1 if the row is not written yet,
+ *          2 if the row was already overwritten by the writer
+ */
+int shm_result_reader_read_row(const shm_result_reader *reader, uint64_t row, double *values)
+{
+  shm_result_header *header = reader->header;
+  const double *rows = (const double*) ((const char*)header + header->rowsOffset);
+  /* the mapping is read-only, so the counter must only be loaded, never modified */
+  uint64_t written = __atomic_load_n(&header->rowsWritten, __ATOMIC_ACQUIRE);
+
+  if (row >= written) {
+    return 1;
+  }
+  if (written - row > header->nRows) {
+    return 2;
+  }
+  memcpy(values, rows + (row % header->nRows) * header->nColumns, header->nColumns * sizeof(double));
+  __atomic_thread_fence(__ATOMIC_ACQUIRE);
+  /* the writer starts to overwrite the slot when rowsWritten reaches row+nRows */
+  written = __atomic_load_n(&header->rowsWritten, __ATOMIC_ACQUIRE);
+  return written - row >= header->nRows ? 2 : 0;
+}
+
+void shm_result_reader_close(shm_result_reader *reader)
+{
+  if (reader->header) {
+    munmap(reader->header, reader->size);
+    reader->header = NULL;
+  }
+  close(reader->fd);
+}
+
+#else /* POSIX shared memory is not available */
+
+void shm_init(simulation_result *self,DATA *data, threadData_t *threadData)
+{
+  throwStreamPrint(threadData, "The shm result format is not supported on this platform");
+}
+
+void shm_emit(simulation_result *self,DATA *data, threadData_t *threadData)
+{
+}
+
+void shm_free(simulation_result *self,DATA *data, threadData_t *threadData)
+{
+}
+
+int shm_result_reader_open(shm_result_reader *reader, const char *name)
+{
+  reader->header = NULL;
+  return 1;
+}
+
+const char* shm_result_reader_column_name(const shm_result_reader *reader, uint32_t column)
+{
+  return NULL;
+}
+
+int shm_result_reader_read_row(const shm_result_reader *reader, uint64_t row, double *values)
+{
+  return 1;
+}
+
+void shm_result_reader_close(shm_result_reader *reader)
+{
+}
+
+#endif
+
+} // extern "C"
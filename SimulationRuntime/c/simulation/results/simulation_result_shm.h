@@ -0,0 +1,94 @@
+/*
+ * This file is part of OpenModelica.
+ *
+ * Copyright (c) 1998-CurrentYear, Open Source Modelica Consortium (OSMC),
+ * c/o Linköpings universitet, Department of Computer and Information Science,
+ * SE-58183 Linköping, Sweden.
+ *
+ * All rights reserved.
+ *
+ * THIS PROGRAM IS PROVIDED UNDER THE TERMS OF THE BSD NEW LICENSE OR THE
+ * GPL VERSION 3 LICENSE OR THE OSMC PUBLIC LICENSE (OSMC-PL) VERSION 1.2.
+ * ANY USE, REPRODUCTION OR DISTRIBUTION OF THIS PROGRAM CONSTITUTES
+ * RECIPIENT'S ACCEPTANCE OF THE OSMC PUBLIC LICENSE OR THE GPL VERSION 3,
+ * ACCORDING TO RECIPIENTS CHOICE.
+ *
+ * The OpenModelica software and the OSMC (Open Source Modelica Consortium)
+ * Public License (OSMC-PL) are obtained from OSMC, either from the above
+ * address, from the URLs: http://www.openmodelica.org or
+ * http://www.ida.liu.se/projects/OpenModelica, and in the OpenModelica
+ * distribution. GNU version 3 is obtained from:
+ * http://www.gnu.org/copyleft/gpl.html. The New BSD License is obtained from:
+ * http://www.opensource.org/licenses/BSD-3-Clause.
+ *
+ * This program is distributed WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE, EXCEPT AS
+ * EXPRESSLY SET FORTH IN THE BY RECIPIENT SELECTED SUBSIDIARY LICENSE
+ * CONDITIONS OF OSMC-PL.
+ *
+ */
+
+/*
+  Publishes results into a POSIX shared-memory ring buffer.
+
+  Local readers can follow a running simulation without file I/O. The
+  segment starts with a shm_result_header, followed by the names of the
+  columns ('\0' separated) and the ring of rows. A row holds time and the
+  (non-filtered) real, integer and boolean variables, all stored as double.
+  The writer publishes a row by incrementing rowsWritten after the row is
+  complete; a reader validates a copied row by checking that rowsWritten
+  did not advance by more than the capacity of the ring in the meantime.
+ */
+
+#ifndef _SIMULATION_RESULT_SHM_H_
+#define _SIMULATION_RESULT_SHM_H_
+
+#include "simulation_result.h"
+#include "simulation_data.h"
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* cplusplus */
+
+#define SHM_RESULT_MAGIC "omcshm1"
+#define SHM_RESULT_ROWS 1024
+
+typedef struct shm_result_header {
+  char magic[8];                    /* SHM_RESULT_MAGIC */
+  uint32_t nColumns;                /* time + reals + integers + booleans */
+  uint32_t nReal;
+  uint32_t nInteger;
+  uint32_t nBoolean;
+  uint32_t nRows;                   /* capacity of the ring */
+  uint32_t namesOffset;             /* offset of the column names */
+  uint64_t rowsOffset;              /* offset of the first row */
+  volatile uint64_t rowsWritten;    /* total number of published rows */
+  volatile uint32_t finished;       /* =1 after the simulation terminated */
+} shm_result_header;
+
+typedef struct shm_result_reader {
+  int fd;
+  size_t size;
+  shm_result_header *header;
+} shm_result_reader;
+
+#if !defined(OMC_MINIMAL_RUNTIME)
+void shm_init(simulation_result *self,DATA *data, threadData_t *threadData);
+void shm_emit(simulation_result *self,DATA *data, threadData_t *threadData);
+void shm_free(simulation_result *self,DATA *data, threadData_t *threadData);
+
+void shm_result_segment_name(const char *filename, char *name, size_t size);
+
+int shm_result_reader_open(shm_result_reader *reader, const char *name);
+const char* shm_result_reader_column_name(const shm_result_reader *reader, uint32_t column);
+int shm_result_reader_read_row(const shm_result_reader *reader, uint64_t row, double *values);
+void shm_result_reader_close(shm_result_reader *reader);
+#endif
+
+#ifdef __cplusplus
+}
+#endif /* cplusplus */
+
+#endif /* _SIMULATION_RESULT_SHM_H_ */
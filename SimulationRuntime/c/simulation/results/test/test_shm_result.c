@@ -0,0 +1,116 @@
+#include <string.h>
+#include <stdio.h>
+#include <sys/mman.h>
+
+#include "simulation_result_shm.h"
+
+/* Publishes rows through the shm result writer and reads them back while
+ * the segment is still written, like a live plotting client would. */
+
+#define N_REAL 2
+#define N_INTEGER 1
+
+int test_read_live(void);
+
+/* main */
+int main()
+{
+  /* return code */
+  int rc;
+
+  if ( (rc = test_read_live()) != 0) return 1000+rc;
+
+  /* everything OK */
+  return 0;
+}
+
+static void emit_row(simulation_result *sim, DATA *data, SIMULATION_DATA *sData, double time)
+{
+  sData->timeValue = time;
+  sData->realVars[0] = 2*time;
+  sData->realVars[1] = -time;
+  sData->integerVars[0] = (modelica_integer) time;
+  sim->emit(sim, data, NULL);
+}
+
+static int check_row(const shm_result_reader *reader, uint64_t row)
+{
+  double values[1+N_REAL+N_INTEGER];
+  double time = (double) row;
+
+  if (shm_result_reader_read_row(reader, row, values) != 0) return 1;
+  if (values[0] != time || values[1] != 2*time || values[2] != -time || values[3] != time) return 2;
+  return 0;
+}
+
+int test_read_live(void)
+{
+  STATIC_REAL_DATA realVarsData[N_REAL];
+  STATIC_INTEGER_DATA integerVarsData[N_INTEGER];
+  modelica_real realVars[N_REAL];
+  modelica_integer integerVars[N_INTEGER];
+  MODEL_DATA modelData;
+  SIMULATION_DATA sData;
+  SIMULATION_DATA *localData[1] = {&sData};
+  DATA data;
+  simulation_result sim;
+  shm_result_reader reader;
+  char name[256];
+  double values[1+N_REAL+N_INTEGER];
+  uint64_t row;
+
+  memset(realVarsData, 0, sizeof(realVarsData));
+  memset(integerVarsData, 0, sizeof(integerVarsData));
+  memset(&modelData, 0, sizeof(modelData));
+  memset(&sData, 0, sizeof(sData));
+  memset(&data, 0, sizeof(data));
+  memset(&sim, 0, sizeof(sim));
+  realVarsData[0].info.name = "x";
+  realVarsData[1].info.name = "y";
+  integerVarsData[0].info.name = "n";
+  modelData.nVariablesReal = N_REAL;
+  modelData.realVarsData = realVarsData;
+  modelData.nVariablesInteger = N_INTEGER;
+  modelData.integerVarsData = integerVarsData;
+  sData.realVars = realVars;
+  sData.integerVars = integerVars;
+  data.modelData = &modelData;
+  data.localData = localData;
+
+  sim.filename = "test_shm_result_res.shm";
+  sim.init = shm_init;
+  sim.emit = shm_emit;
+  sim.free = shm_free;
+  sim.init(&sim, &data, NULL);
+
+  shm_result_segment_name(sim.filename, name, sizeof(name));
+  if (shm_result_reader_open(&reader, name) != 0) return 1;
+  if (reader.header->nColumns != 1+N_REAL+N_INTEGER) return 2;
+  if (strcmp(shm_result_reader_column_name(&reader, 3), "n") != 0) return 3;
+
+  /* nothing published yet */
+  if (shm_result_reader_read_row(&reader, 0, values) != 1) return 4;
+
+  for (row=0; row<10; row++) {
+    emit_row(&sim, &data, &sData, (double) row);
+  }
+  for (row=0; row<10; row++) {
+    if (check_row(&reader, row) != 0) return 5;
+  }
+
+  /* wrap the ring: the first rows are overwritten, the latest are still readable */
+  for (row=10; row<2*SHM_RESULT_ROWS; row++) {
+    emit_row(&sim, &data, &sData, (double) row);
+  }
+  if (shm_result_reader_read_row(&reader, 0, values) != 2) return 6;
+  if (check_row(&reader, 2*SHM_RESULT_ROWS-1) != 0) return 7;
+
+  /* the rows stay readable after the writer finished */
+  sim.free(&sim, &data, NULL);
+  if (!reader.header->finished) return 8;
+  if (check_row(&reader, 2*SHM_RESULT_ROWS-1) != 0) return 9;
+  shm_result_reader_close(&reader);
+  shm_unlink(name);
+
+  return 0;
+}
@@ -72,6 +72,7 @@
 #include "simulation/results/simulation_result_csv.h"
 #include "simulation/results/simulation_result_mat.h"
 #include "simulation/results/simulation_result_wall.h"
+#include "simulation/results/simulation_result_shm.h"
 #include "simulation/results/simulation_result_ia.h"
 #include "simulation/solver/solver_main.h"
 #include "simulation_info_json.h"
@@ -607,6 +608,10 @@ int initializeResultData(DATA* simData, threadData_t *threadData, int cpuTime)
     sim_result.writeParameterData = recon_wall_writeParameterData;
     sim_result.free = recon_wall_free;
     resultFormatHasCheapAliasesAndParameters = 1;
+  } else if(0 == strcmp("shm", simData->simulationInfo->outputFormat)) {
+    sim_result.init = shm_init;
+    sim_result.emit = shm_emit;
+    sim_result.free = shm_free;
   } else if(0 == strcmp("plt", simData->simulationInfo->outputFormat)) {
     sim_result.init = plt_init;
     sim_result.emit = plt_emit;
@@ -791,6 +796,7 @@ int initRuntimeAndSimulation(int argc, char**argv, DATA *data, threadData_t *thr
   data->simulationInfo->lsMethod = getlinearSolverMethod();
   data->simulationInfo->lssMethod = getlinearSparseSolverMethod();
   data->simulationInfo->newtonStrategy = getNewtonStrategy();
+  data->simulationInfo->newtonJacobianReuse = omc_flag[FLAG_NEWTON_JACOBIAN_REUSE];
   data->simulationInfo->nlsCsvInfomation = omc_flag[FLAG_NLS_INFO];
 
   if(omc_flag[FLAG_LSS_MAX_DENSITY]) {
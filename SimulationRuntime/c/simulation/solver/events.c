@@ -83,6 +83,19 @@ void checkForSampleEvent(DATA *data, SOLVER_INFO* solverInfo)
   TRACE_POP
 }
 
+/* number of zero-crossings scanned at once by checkForStateEvent */
+#define ZERO_CROSSING_BLOCK 64
+
+/*! \fn zeroCrossingChanged
+ *
+ *  Branch free version of sign(zc) != sign(zcPre), so the block scan in
+ *  checkForStateEvent can be vectorized by the compiler.
+ */
+static inline int zeroCrossingChanged(double zc, double zcPre)
+{
+  return ((zc > 0) - (zc < 0)) != ((zcPre > 0) - (zcPre < 0));
+}
+
 /*! \fn checkForStateEvent
  *
  *  \param [ref] [data]
@@ -95,31 +108,53 @@ void checkForSampleEvent(DATA *data, SOLVER_INFO* solverInfo)
 int checkForStateEvent(DATA* data, LIST *eventList)
 {
   TRACE_PUSH
-  long i=0;
+  long i=0, j;
+  const long nZeroCrossings = data->modelData->nZeroCrossings;
+  const modelica_real *zeroCrossings = data->simulationInfo->zeroCrossings;
+  const modelica_real *zeroCrossingsPre = data->simulationInfo->zeroCrossingsPre;
 
-  debugStreamPrint(LOG_EVENTS, 1, "check state-event zerocrossing at time %g",  data->localData[0]->timeValue);
-
-  for(i=0; i<data->modelData->nZeroCrossings; i++)
+  if (DEBUG_STREAM(LOG_EVENTS))
   {
-    int *eq_indexes;
-    const char *exp_str = data->callback->zeroCrossingDescription(i,&eq_indexes);
-    debugStreamPrintWithEquationIndexes(LOG_EVENTS, 1, eq_indexes, "%s", exp_str);
+    debugStreamPrint(LOG_EVENTS, 1, "check state-event zerocrossing at time %g",  data->localData[0]->timeValue);
 
-    if(sign(data->simulationInfo->zeroCrossings[i]) != sign(data->simulationInfo->zeroCrossingsPre[i]))
+    for(i=0; i<nZeroCrossings; i++)
     {
-      debugStreamPrint(LOG_EVENTS, 0, "changed:   %s", (data->simulationInfo->zeroCrossingsPre[i] > 0) ? "TRUE -> FALSE" : "FALSE -> TRUE");
-      listPushFront(eventList, &(data->simulationInfo->zeroCrossingIndex[i]));
+      int *eq_indexes;
+      const char *exp_str = data->callback->zeroCrossingDescription(i,&eq_indexes);
+      debugStreamPrintWithEquationIndexes(LOG_EVENTS, 1, eq_indexes, "%s", exp_str);
+
+      if(sign(zeroCrossings[i]) != sign(zeroCrossingsPre[i]))
+      {
+        debugStreamPrint(LOG_EVENTS, 0, "changed:   %s", (zeroCrossingsPre[i] > 0) ? "TRUE -> FALSE" : "FALSE -> TRUE");
+        listPushFront(eventList, &(data->simulationInfo->zeroCrossingIndex[i]));
+      }
+      else
+      {
+        debugStreamPrint(LOG_EVENTS, 0, "unchanged: %s", (zeroCrossingsPre[i] > 0) ? "TRUE -- TRUE" : "FALSE -- FALSE");
+      }
+
+      messageClose(LOG_EVENTS);
     }
-    else
+    messageClose(LOG_EVENTS);
+  }
+  else
+  {
+    /* scan a block for any change first and only look at the single
+     * zero-crossings of blocks that contain an event */
+    for(i=0; i<nZeroCrossings; i+=ZERO_CROSSING_BLOCK)
     {
-      debugStreamPrint(LOG_EVENTS, 0, "unchanged: %s", (data->simulationInfo->zeroCrossingsPre[i] > 0) ? "TRUE -- TRUE" : "FALSE -- FALSE");
-    }
+      const long blockEnd = i+ZERO_CROSSING_BLOCK < nZeroCrossings ? i+ZERO_CROSSING_BLOCK : nZeroCrossings;
+      int changed = 0;
 
-    if (DEBUG_STREAM(LOG_EVENTS))
-      messageClose(LOG_EVENTS);
+      for(j=i; j<blockEnd; j++)
+        changed |= zeroCrossingChanged(zeroCrossings[j], zeroCrossingsPre[j]);
+
+      if(changed)
+        for(j=i; j<blockEnd; j++)
+          if(zeroCrossingChanged(zeroCrossings[j], zeroCrossingsPre[j]))
+            listPushFront(eventList, &(data->simulationInfo->zeroCrossingIndex[j]));
+    }
   }
-  if (DEBUG_STREAM(LOG_EVENTS))
-    messageClose(LOG_EVENTS);
 
   if(listLen(eventList) > 0)
   {
@@ -186,7 +221,7 @@ void handleEvents(DATA* data, threadData_t *threadData, LIST* eventLst, double *
 {
   TRACE_PUSH
   double time = data->localData[0]->timeValue;
-  long i;
+  long i, j;
   LIST_NODE* it;
 
   /* time event */
@@ -194,13 +229,16 @@ void handleEvents(DATA* data, threadData_t *threadData, LIST* eventLst, double *
   {
     storePreValues(data);
 
-    /* activate time event */
-    for(i=0; i<data->modelData->nSamples; ++i)
-      if(data->simulationInfo->nextSampleTimes[i] <= time + SAMPLE_EPS)
-      {
-        data->simulationInfo->samples[i] = 1;
-        infoStreamPrint(LOG_EVENTS, 0, "[%ld] sample(%g, %g)", data->modelData->samplesInfo[i].index, data->modelData->samplesInfo[i].start, data->modelData->samplesInfo[i].interval);
-      }
+    /* activate all time events that are due */
+    data->simulationInfo->nActiveSamples = 0;
+    while(heapLen(data->simulationInfo->sampleQueue) > 0 && heapTopKey(data->simulationInfo->sampleQueue) <= time + SAMPLE_EPS)
+    {
+      i = *((long*) heapTopData(data->simulationInfo->sampleQueue));
+      heapPop(data->simulationInfo->sampleQueue);
+      data->simulationInfo->samples[i] = 1;
+      data->simulationInfo->activeSamples[data->simulationInfo->nActiveSamples++] = i;
+      infoStreamPrint(LOG_EVENTS, 0, "[%ld] sample(%g, %g)", data->modelData->samplesInfo[i].index, data->modelData->samplesInfo[i].start, data->modelData->samplesInfo[i].interval);
+    }
   }
   data->simulationInfo->chatteringInfo.lastStepsNumStateEvents-=data->simulationInfo->chatteringInfo.lastSteps[data->simulationInfo->chatteringInfo.currentIndex];
   /* state event */
@@ -259,19 +297,18 @@ void handleEvents(DATA* data, threadData_t *threadData, LIST* eventLst, double *
   /* time event */
   if(data->simulationInfo->sampleActivated)
   {
-    /* deactivate time events */
-    for(i=0; i<data->modelData->nSamples; ++i)
+    /* deactivate time events and schedule their next activation */
+    for(j=0; j<data->simulationInfo->nActiveSamples; ++j)
     {
-      if(data->simulationInfo->samples[i])
-      {
-        data->simulationInfo->samples[i] = 0;
-        data->simulationInfo->nextSampleTimes[i] += data->modelData->samplesInfo[i].interval;
-      }
+      i = data->simulationInfo->activeSamples[j];
+      data->simulationInfo->samples[i] = 0;
+      data->simulationInfo->nextSampleTimes[i] += data->modelData->samplesInfo[i].interval;
+      heapPush(data->simulationInfo->sampleQueue, data->simulationInfo->nextSampleTimes[i], &i);
     }
+    data->simulationInfo->nActiveSamples = 0;
 
-    for(i=0; i<data->modelData->nSamples; ++i)
-      if((i == 0) || (data->simulationInfo->nextSampleTimes[i] < data->simulationInfo->nextSampleEvent))
-        data->simulationInfo->nextSampleEvent = data->simulationInfo->nextSampleTimes[i];
+    if(heapLen(data->simulationInfo->sampleQueue) > 0)
+      data->simulationInfo->nextSampleEvent = heapTopKey(data->simulationInfo->sampleQueue);
 
     data->simulationInfo->sampleActivated = 0;
 
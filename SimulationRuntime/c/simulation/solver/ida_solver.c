@@ -63,6 +63,10 @@
 #include <idas/idas_spgmr.h>
 #include <idas/idas_spbcgs.h>
 #include <idas/idas_sptfqmr.h>
+#include <idas/idas_spils.h>
+
+/* size of the diagonal blocks of the block Jacobi preconditioner */
+#define IDA_PRECOND_BLOCK_SIZE 8
 
 
 static int jacobianOwnNumColoredIDA(long int Neq, realtype tt, realtype cj,
@@ -81,6 +85,18 @@ static int jacobiancoloredKLUNum(realtype tt, realtype cj,
     N_Vector yy, N_Vector yp, N_Vector rr, SlsMat Jac, void *user_data,
     N_Vector tmp1, N_Vector tmp2, N_Vector tmp3);
 
+static int jacobianTimesVectorSymIDA(realtype tt, N_Vector yy, N_Vector yp,
+    N_Vector rr, N_Vector v, N_Vector Jv, realtype cj, void *user_data,
+    N_Vector tmp1, N_Vector tmp2);
+
+static int preconditionerSetupIDA(realtype tt, N_Vector yy, N_Vector yp,
+    N_Vector rr, realtype cj, void *user_data,
+    N_Vector tmp1, N_Vector tmp2, N_Vector tmp3);
+
+static int preconditionerSolveIDA(realtype tt, N_Vector yy, N_Vector yp,
+    N_Vector rr, N_Vector rvec, N_Vector zvec, realtype cj, realtype delta,
+    void *user_data, N_Vector tmp);
+
 static int residualFunctionIDA(double time, N_Vector yy, N_Vector yp, N_Vector res, void* userData);
 int rootsFunctionIDA(double time, N_Vector yy, N_Vector yp, double *gout, void* userData);
 
@@ -123,6 +139,7 @@ ida_solver_initial(DATA* data, threadData_t *threadData, SOLVER_INFO* solverInfo
   int flag;
   long int i;
   double* tmp;
+  int sparsePatternAvailable;
 
   /* default max order */
   int maxOrder = 5;
@@ -134,6 +151,17 @@ ida_solver_initial(DATA* data, threadData_t *threadData, SOLVER_INFO* solverInfo
 
   /* initialize constants */
   idaData->setInitialSolution = 0;
+  idaData->tmpJac = NULL;
+  idaData->preconditioner = IDA_PRECOND_NONE;
+  idaData->precondJac = NULL;
+  idaData->precondRowPtr = NULL;
+  idaData->precondColIdx = NULL;
+  idaData->precondDiag = NULL;
+  idaData->precondWork = NULL;
+  idaData->precondVal = NULL;
+  idaData->precondBlocks = NULL;
+  idaData->precondPivots = NULL;
+  idaData->odeEvaluated = 0;
 
   /* start initialization routines of sundials */
   idaData->ida_mem = IDACreate();
@@ -393,6 +421,7 @@ ida_solver_initial(DATA* data, threadData_t *threadData, SOLVER_INFO* solverInfo
 
   /* selects the calculation method of the jacobian */
 /* in daeMode sparse pattern is already initialized in DAEMODE_DATA */
+  sparsePatternAvailable = idaData->daeMode;
   if(!idaData->daeMode && (idaData->jacobianMethod == COLOREDNUMJAC ||
       idaData->jacobianMethod == COLOREDSYMJAC ||
       idaData->jacobianMethod == KLUSPARSE ||
@@ -403,6 +432,10 @@ ida_solver_initial(DATA* data, threadData_t *threadData, SOLVER_INFO* solverInfo
       infoStreamPrint(LOG_STDOUT, 0, "Jacobian or SparsePattern is not generated or failed to initialize! Switch back to normal.");
       idaData->jacobianMethod = INTERNALNUMJAC;
     }
+    else
+    {
+      sparsePatternAvailable = 1;
+    }
   }
 
   /* set up the appropriate function pointer */
@@ -433,6 +466,34 @@ ida_solver_initial(DATA* data, threadData_t *threadData, SOLVER_INFO* solverInfo
       break;
     }
   }
+  else if (idaData->linearSolverMethod == IDA_LS_SPGMR ||
+           idaData->linearSolverMethod == IDA_LS_SPBCG ||
+           idaData->linearSolverMethod == IDA_LS_SPTFQMR)
+  {
+    switch (idaData->jacobianMethod){
+    case SYMJAC:
+    case COLOREDSYMJAC:
+      if (idaData->daeMode)
+      {
+        infoStreamPrint(LOG_STDOUT, 0, "The symbolic jacobian is not available in daeMode, yet! Switch back to internal.");
+        idaData->jacobianMethod = INTERNALNUMJAC;
+      }
+      else
+      {
+        /* jacobian-vector products from the directional derivatives */
+        flag = IDASpilsSetJacTimesVecFn(idaData->ida_mem, jacobianTimesVectorSymIDA);
+      }
+      break;
+    case COLOREDNUMJAC:
+    case NUMJAC:
+    case INTERNALNUMJAC:
+      /* jacobian-vector products are approximated by ida with difference quotients */
+      break;
+    default:
+      throwStreamPrint(threadData,"unrecognized jacobian calculation method %s", (const char*)omc_flagValue[FLAG_JACOBIAN]);
+      break;
+    }
+  }
   else
   {
     switch (idaData->jacobianMethod){
@@ -461,6 +522,82 @@ ida_solver_initial(DATA* data, threadData_t *threadData, SOLVER_INFO* solverInfo
     infoStreamPrint(LOG_SOLVER, 0, "jacobian is calculated by %s", JACOBIAN_METHOD_DESC[idaData->jacobianMethod]);
   }
 
+  /* if FLAG_IDA_PRECOND is set, choose the preconditioner of the iterative linear solvers */
+  if (idaData->linearSolverMethod == IDA_LS_SPGMR ||
+      idaData->linearSolverMethod == IDA_LS_SPBCG ||
+      idaData->linearSolverMethod == IDA_LS_SPTFQMR)
+  {
+    if (omc_flag[FLAG_IDA_PRECOND])
+    {
+      idaData->preconditioner = IDA_PRECOND_UNKNOWN;
+      for(i=1; i< IDA_PRECOND_MAX;i++)
+      {
+        if(!strcmp((const char*)omc_flagValue[FLAG_IDA_PRECOND], IDA_PRECOND_METHOD[i])){
+          idaData->preconditioner = (int)i;
+          break;
+        }
+      }
+      if(idaData->preconditioner == IDA_PRECOND_UNKNOWN)
+      {
+        if (ACTIVE_WARNING_STREAM(LOG_SOLVER))
+        {
+          warningStreamPrint(LOG_SOLVER, 1, "unrecognized ida preconditioner %s, current options are:", (const char*)omc_flagValue[FLAG_IDA_PRECOND]);
+          for(i=1; i < IDA_PRECOND_MAX; ++i)
+          {
+            warningStreamPrint(LOG_SOLVER, 0, "%-15s [%s]", IDA_PRECOND_METHOD[i], IDA_PRECOND_METHOD_DESC[i]);
+          }
+          messageClose(LOG_SOLVER);
+        }
+        throwStreamPrint(threadData,"unrecognized ida preconditioner %s", (const char*)omc_flagValue[FLAG_IDA_PRECOND]);
+      }
+    }
+    else
+    {
+      idaData->preconditioner = IDA_PRECOND_ILU;
+    }
+
+    if (idaData->preconditioner != IDA_PRECOND_NONE && !sparsePatternAvailable)
+    {
+      infoStreamPrint(LOG_STDOUT, 0, "The ida preconditioner needs the SparsePattern of the jacobian! Switch back to no preconditioner.");
+      idaData->preconditioner = IDA_PRECOND_NONE;
+    }
+
+    if (idaData->preconditioner != IDA_PRECOND_NONE)
+    {
+      if (idaData->daeMode)
+      {
+        idaData->NNZ = data->simulationInfo->daeModeData->sparsePattern->numberOfNoneZeros;
+      }
+      else
+      {
+        idaData->NNZ = data->simulationInfo->analyticJacobians[data->callback->INDEX_JAC_A].sparsePattern.numberOfNoneZeros;
+      }
+      idaData->precondJac = NewSparseMat(idaData->N, idaData->N, idaData->NNZ);
+
+      if (idaData->preconditioner == IDA_PRECOND_ILU)
+      {
+        /* the pattern plus all diagonal elements, no fill-in */
+        idaData->precondRowPtr = (int*) malloc((idaData->N+1)*sizeof(int));
+        idaData->precondColIdx = (int*) malloc((idaData->NNZ+idaData->N)*sizeof(int));
+        idaData->precondDiag = (int*) malloc(idaData->N*sizeof(int));
+        idaData->precondWork = (int*) malloc(idaData->N*sizeof(int));
+        idaData->precondVal = (double*) malloc((idaData->NNZ+idaData->N)*sizeof(double));
+      }
+      else
+      {
+        long int nBlocks = (idaData->N + IDA_PRECOND_BLOCK_SIZE - 1) / IDA_PRECOND_BLOCK_SIZE;
+        idaData->precondBlocks = (double*) malloc(nBlocks*IDA_PRECOND_BLOCK_SIZE*IDA_PRECOND_BLOCK_SIZE*sizeof(double));
+        idaData->precondPivots = (int*) malloc(nBlocks*IDA_PRECOND_BLOCK_SIZE*sizeof(int));
+      }
+
+      flag = IDASpilsSetPreconditioner(idaData->ida_mem, preconditionerSetupIDA, preconditionerSolveIDA);
+      if (checkIDAflag(flag)){
+        throwStreamPrint(threadData, "##IDA## Setting preconditioner fails while initialize IDA solver!");
+      }
+    }
+    infoStreamPrint(LOG_SOLVER, 0, "ida preconditioner selected %s", IDA_PRECOND_METHOD_DESC[idaData->preconditioner]);
+  }
+
   /* set max error test fails */
   if (omc_flag[FLAG_IDA_MAXERRORTESTFAIL])
   {
@@ -562,11 +699,19 @@ ida_solver_initial(DATA* data, threadData_t *threadData, SOLVER_INFO* solverInfo
       }
     }
 
-    flag = IDASensInit(idaData->ida_mem, idaData->Np, IDA_SIMULTANEOUS, NULL, idaData->yS, idaData->ySp);
+    /* the staggered corrector solves the sensitivity systems only after the
+     * states converged and reuses their iteration matrix */
+    flag = IDASensInit(idaData->ida_mem, idaData->Np, IDA_STAGGERED, NULL, idaData->yS, idaData->ySp);
     if (checkIDAflag(flag)){
       throwStreamPrint(threadData, "##IDA## set IDASensInit failed!");
     }
 
+    idaData->sensParams = (double*) malloc(idaData->Np*sizeof(double));
+    for(i=0; i<idaData->Np; ++i)
+    {
+      idaData->sensParams[i] = data->simulationInfo->realParameter[data->simulationInfo->sensitivityParList[i]];
+    }
+
     flag = IDASetSensParams(idaData->ida_mem, data->simulationInfo->realParameter, NULL, data->simulationInfo->sensitivityParList);
     if (checkIDAflag(flag)){
       throwStreamPrint(threadData, "##IDA## set IDASetSensParams failed!");
@@ -613,6 +758,17 @@ ida_solver_deinitial(IDA_SOLVER *idaData){
   if (!idaData->daeMode && idaData->linearSolverMethod == IDA_LS_KLU){
     DestroySparseMat(idaData->tmpJac);
   }
+  if (idaData->precondJac)
+  {
+    DestroySparseMat(idaData->precondJac);
+  }
+  free(idaData->precondRowPtr);
+  free(idaData->precondColIdx);
+  free(idaData->precondDiag);
+  free(idaData->precondWork);
+  free(idaData->precondVal);
+  free(idaData->precondBlocks);
+  free(idaData->precondPivots);
 
   if (idaData->daeMode)
   {
@@ -625,6 +781,7 @@ ida_solver_deinitial(IDA_SOLVER *idaData){
     N_VDestroyVectorArray_Serial(idaData->yS, idaData->Np);
     N_VDestroyVectorArray_Serial(idaData->ySp, idaData->Np);
     N_VDestroyVectorArray_Serial(idaData->ySResult, idaData->Np);
+    free(idaData->sensParams);
   }
 
   N_VDestroy_Serial(idaData->errwgt);
@@ -702,7 +859,7 @@ ida_solver_step(DATA* data, threadData_t *threadData, SOLVER_INFO* solverInfo)
           NV_Ith_S(idaData->ySp[i],j) = 0;
         }
       }
-      flag = IDASensReInit(idaData->ida_mem, IDA_SIMULTANEOUS, idaData->yS, idaData->ySp);
+      flag = IDASensReInit(idaData->ida_mem, IDA_STAGGERED, idaData->yS, idaData->ySp);
       if (checkIDAflag(flag)){
         throwStreamPrint(threadData, "##IDA## set IDASensInit failed!");
       }
@@ -890,6 +1047,12 @@ ida_solver_step(DATA* data, threadData_t *threadData, SOLVER_INFO* solverInfo)
   {
     flag = IDASlsGetNumJacEvals(idaData->ida_mem, &tmp);
   }
+  else if (idaData->linearSolverMethod == IDA_LS_SPGMR ||
+           idaData->linearSolverMethod == IDA_LS_SPBCG ||
+           idaData->linearSolverMethod == IDA_LS_SPTFQMR)
+  {
+    flag = IDASpilsGetNumPrecEvals(idaData->ida_mem, &tmp);
+  }
   else
   {
     flag = IDADlsGetNumJacEvals(idaData->ida_mem, &tmp);
@@ -922,6 +1085,26 @@ ida_solver_step(DATA* data, threadData_t *threadData, SOLVER_INFO* solverInfo)
   return retVal;
 }
 
+/*
+ * ida perturbs the sensitivity parameters in place for the difference quotients
+ * of the sensitivity residuals. Returns 1 if they changed since the last call,
+ * so the bound parameters are only updated when needed.
+ */
+static int sensitivityParametersChanged(IDA_SOLVER* idaData, DATA* data)
+{
+  int i, changed = 0;
+  for(i = 0; i < idaData->Np; ++i)
+  {
+    double p = data->simulationInfo->realParameter[data->simulationInfo->sensitivityParList[i]];
+    if (p != idaData->sensParams[i])
+    {
+      idaData->sensParams[i] = p;
+      changed = 1;
+    }
+  }
+  return changed;
+}
+
 int residualFunctionIDA(double time, N_Vector yy, N_Vector yp, N_Vector res, void* userData)
 {
   TRACE_PUSH
@@ -952,8 +1135,8 @@ int residualFunctionIDA(double time, N_Vector yy, N_Vector yp, N_Vector res, voi
   MMC_TRY_INTERNAL(simulationJumpBuffer)
 #endif
 
-  /* if sensitivity mode update also bound parameters*/
-  if (idaData->idaSmode)
+  /* if sensitivity mode update also bound parameters, if ida perturbed the parameters */
+  if (idaData->idaSmode && sensitivityParametersChanged(idaData, data))
   {
     data->callback->updateBoundParameters(data, threadData);
   }
@@ -1003,6 +1186,7 @@ int residualFunctionIDA(double time, N_Vector yy, N_Vector yp, N_Vector res, voi
   }
 
   printVector(LOG_DASSL_STATES, "delta", delta, idaData->N, time);
+  idaData->odeEvaluated = 0;
   success = 1;
 #if !defined(OMC_EMCC)
   MMC_CATCH_INTERNAL(simulationJumpBuffer)
@@ -1524,4 +1708,409 @@ static int jacobianSparseNum(double tt, double cj,
   return 0;
 }
 
+/*
+ * function calculates the jacobian-vector product Jv = (dF/dy + cj*dF/dyp)*v
+ * with the directional derivative of the generated symbolic jacobian.
+ * Only used in ode mode, where F = f(y) - yp and Jv = A*v - cj*v.
+ */
+static int jacobianTimesVectorSymIDA(double tt, N_Vector yy, N_Vector yp,
+    N_Vector rr, N_Vector v, N_Vector Jv, double cj, void *user_data,
+    N_Vector tmp1, N_Vector tmp2)
+{
+  TRACE_PUSH
+  IDA_SOLVER* idaData = (IDA_SOLVER*)user_data;
+  DATA* data = (DATA*)(((IDA_USERDATA*)idaData->simData)->data);
+  threadData_t* threadData = (threadData_t*)(((IDA_USERDATA*)idaData->simData)->threadData);
+  ANALYTIC_JACOBIAN* jacobian = &(data->simulationInfo->analyticJacobians[data->callback->INDEX_JAC_A]);
+
+  double *states = N_VGetArrayPointer(yy);
+  double *vv = N_VGetArrayPointer(v);
+  double *jv = N_VGetArrayPointer(Jv);
+  double timeBackup;
+  long int i;
+  int saveJumpState;
+  int success = 0, retVal = 0;
+
+  setContext(data, &tt, CONTEXT_JACOBIAN);
+  timeBackup = data->localData[0]->timeValue;
+  data->localData[0]->timeValue = tt;
+
+  saveJumpState = threadData->currentErrorStage;
+  threadData->currentErrorStage = ERROR_INTEGRATOR;
+
+  /* try */
+#if !defined(OMC_EMCC)
+  MMC_TRY_INTERNAL(simulationJumpBuffer)
+#endif
+
+  /* the krylov solver calls this function several times at the same point,
+   * so the ode is only evaluated after the residual function was called */
+  if (!idaData->odeEvaluated)
+  {
+    if (states != data->localData[0]->realVars)
+    {
+      memcpy(data->localData[0]->realVars, states, sizeof(double)*data->modelData->nStates);
+    }
+    externalInputUpdate(data);
+    data->callback->input_function(data, threadData);
+    data->callback->functionODE(data, threadData);
+    idaData->odeEvaluated = 1;
+  }
+
+  /* directional derivative A*v */
+  memcpy(jacobian->seedVars, vv, sizeof(double)*idaData->N);
+  data->callback->functionJacA_column(data, threadData);
+  for(i = 0; i < idaData->N; i++)
+  {
+    jv[i] = jacobian->resultVars[i] - cj * vv[i];
+  }
+  memset(jacobian->seedVars, 0, sizeof(double)*idaData->N);
+
+  increaseJacContext(data);
+  success = 1;
+#if !defined(OMC_EMCC)
+  MMC_CATCH_INTERNAL(simulationJumpBuffer)
+#endif
+
+  if (!success) {
+    /* recoverable error, ida retries with a smaller step */
+    retVal = 1;
+  }
+
+  threadData->currentErrorStage = saveJumpState;
+  data->localData[0]->timeValue = timeBackup;
+  unsetContext(data);
+
+  TRACE_POP
+  return retVal;
+}
+
+/* Returns the range [*begin,*end) of column col in the sparse pattern */
+static void sparsePatternColumnIDA(IDA_SOLVER* idaData, SPARSE_PATTERN* sparsePattern, long int col, int *begin, int *end)
+{
+  if (idaData->daeMode)
+  {
+    *begin = sparsePattern->leadindex[col];
+    *end = sparsePattern->leadindex[col+1];
+  }
+  else
+  {
+    *begin = (col == 0) ? 0 : sparsePattern->leadindex[col-1];
+    *end = sparsePattern->leadindex[col];
+  }
+}
+
+/*
+ * ILU(0) preconditioner: copies the iteration matrix from the positions of
+ * the sparse pattern to CSR format, adding the missing diagonal elements,
+ * and factorizes it in place without fill-in.
+ */
+static void preconditionerSetupILU(IDA_SOLVER* idaData, SPARSE_PATTERN* sparsePattern, const double *jac, double cj)
+{
+  const long int N = idaData->N;
+  int *rowPtr = idaData->precondRowPtr;
+  int *colIdx = idaData->precondColIdx;
+  int *diag = idaData->precondDiag;
+  int *work = idaData->precondWork;
+  double *val = idaData->precondVal;
+  const double diagShift = idaData->daeMode ? 0.0 : -cj;
+  long int i, j;
+  int p, q, r, begin, end, hasDiag;
+
+  /* count the elements of each row */
+  memset(rowPtr, 0, (N+1)*sizeof(int));
+  for(j = 0; j < N; j++)
+  {
+    hasDiag = 0;
+    sparsePatternColumnIDA(idaData, sparsePattern, j, &begin, &end);
+    for(p = begin; p < end; p++)
+    {
+      rowPtr[sparsePattern->index[p]+1]++;
+      hasDiag |= (sparsePattern->index[p] == j);
+    }
+    if (!hasDiag)
+    {
+      rowPtr[j+1]++;
+    }
+  }
+  for(i = 0; i < N; i++)
+  {
+    rowPtr[i+1] += rowPtr[i];
+  }
+
+  /* fill the rows column by column, so each row is sorted */
+  memcpy(work, rowPtr, N*sizeof(int));
+  for(j = 0; j < N; j++)
+  {
+    hasDiag = 0;
+    sparsePatternColumnIDA(idaData, sparsePattern, j, &begin, &end);
+    for(p = begin; p < end; p++)
+    {
+      i = sparsePattern->index[p];
+      q = work[i]++;
+      colIdx[q] = j;
+      val[q] = jac[p];
+      if (i == j)
+      {
+        val[q] += diagShift;
+        diag[i] = q;
+        hasDiag = 1;
+      }
+    }
+    if (!hasDiag)
+    {
+      q = work[j]++;
+      colIdx[q] = j;
+      val[q] = diagShift;
+      diag[j] = q;
+    }
+  }
+
+  /* incomplete factorization, work maps the columns of the current row */
+  for(i = 0; i < N; i++)
+  {
+    work[i] = -1;
+  }
+  for(i = 0; i < N; i++)
+  {
+    for(q = rowPtr[i]; q < rowPtr[i+1]; q++)
+    {
+      work[colIdx[q]] = q;
+    }
+    for(p = rowPtr[i]; p < diag[i]; p++)
+    {
+      j = colIdx[p];
+      val[p] /= val[diag[j]];
+      for(r = diag[j]+1; r < rowPtr[j+1]; r++)
+      {
+        if (work[colIdx[r]] >= 0)
+        {
+          val[work[colIdx[r]]] -= val[p] * val[r];
+        }
+      }
+    }
+    if (fabs(val[diag[i]]) < DBL_EPSILON)
+    {
+      val[diag[i]] = (val[diag[i]] < 0) ? -DBL_EPSILON : DBL_EPSILON;
+    }
+    for(q = rowPtr[i]; q < rowPtr[i+1]; q++)
+    {
+      work[colIdx[q]] = -1;
+    }
+  }
+}
+
+static void preconditionerSolveILU(IDA_SOLVER* idaData, double *z)
+{
+  const int *rowPtr = idaData->precondRowPtr;
+  const int *colIdx = idaData->precondColIdx;
+  const int *diag = idaData->precondDiag;
+  const double *val = idaData->precondVal;
+  long int i;
+  int p;
+
+  /* L has a unit diagonal */
+  for(i = 0; i < idaData->N; i++)
+  {
+    for(p = rowPtr[i]; p < diag[i]; p++)
+    {
+      z[i] -= val[p] * z[colIdx[p]];
+    }
+  }
+  for(i = idaData->N-1; i >= 0; i--)
+  {
+    for(p = diag[i]+1; p < rowPtr[i+1]; p++)
+    {
+      z[i] -= val[p] * z[colIdx[p]];
+    }
+    z[i] /= val[diag[i]];
+  }
+}
+
+/*
+ * block Jacobi preconditioner: LU factorization with partial pivoting
+ * of the dense diagonal blocks of the iteration matrix
+ */
+static void preconditionerSetupBlockJacobi(IDA_SOLVER* idaData, SPARSE_PATTERN* sparsePattern, const double *jac, double cj)
+{
+  const int bs = IDA_PRECOND_BLOCK_SIZE;
+  const long int N = idaData->N;
+  const long int nBlocks = (N + bs - 1) / bs;
+  long int b, i, j;
+  int p, k, n, piv, begin, end;
+
+  memset(idaData->precondBlocks, 0, nBlocks*bs*bs*sizeof(double));
+  for(j = 0; j < N; j++)
+  {
+    double *block = idaData->precondBlocks + (j/bs)*bs*bs;
+    sparsePatternColumnIDA(idaData, sparsePattern, j, &begin, &end);
+    for(p = begin; p < end; p++)
+    {
+      i = sparsePattern->index[p];
+      if (i/bs == j/bs)
+      {
+        block[(i%bs) + (j%bs)*bs] = jac[p];
+      }
+    }
+    if (!idaData->daeMode)
+    {
+      block[(j%bs) + (j%bs)*bs] -= cj;
+    }
+  }
+
+  for(b = 0; b < nBlocks; b++)
+  {
+    double *block = idaData->precondBlocks + b*bs*bs;
+    int *pivots = idaData->precondPivots + b*bs;
+    n = (N - b*bs < bs) ? (int)(N - b*bs) : bs;
+    for(k = 0; k < n; k++)
+    {
+      piv = k;
+      for(i = k+1; i < n; i++)
+      {
+        if (fabs(block[i + k*bs]) > fabs(block[piv + k*bs]))
+        {
+          piv = (int)i;
+        }
+      }
+      pivots[k] = piv;
+      if (piv != k)
+      {
+        for(j = 0; j < n; j++)
+        {
+          double t = block[k + j*bs];
+          block[k + j*bs] = block[piv + j*bs];
+          block[piv + j*bs] = t;
+        }
+      }
+      if (fabs(block[k + k*bs]) < DBL_EPSILON)
+      {
+        block[k + k*bs] = (block[k + k*bs] < 0) ? -DBL_EPSILON : DBL_EPSILON;
+      }
+      for(i = k+1; i < n; i++)
+      {
+        block[i + k*bs] /= block[k + k*bs];
+        for(j = k+1; j < n; j++)
+        {
+          block[i + j*bs] -= block[i + k*bs] * block[k + j*bs];
+        }
+      }
+    }
+  }
+}
+
+static void preconditionerSolveBlockJacobi(IDA_SOLVER* idaData, double *z)
+{
+  const int bs = IDA_PRECOND_BLOCK_SIZE;
+  const long int nBlocks = (idaData->N + bs - 1) / bs;
+  long int b;
+  int i, j, n;
+
+  for(b = 0; b < nBlocks; b++)
+  {
+    const double *block = idaData->precondBlocks + b*bs*bs;
+    const int *pivots = idaData->precondPivots + b*bs;
+    double *zb = z + b*bs;
+    n = (idaData->N - b*bs < bs) ? (int)(idaData->N - b*bs) : bs;
+    for(i = 0; i < n; i++)
+    {
+      if (pivots[i] != i)
+      {
+        double t = zb[i];
+        zb[i] = zb[pivots[i]];
+        zb[pivots[i]] = t;
+      }
+    }
+    for(i = 0; i < n; i++)
+    {
+      for(j = 0; j < i; j++)
+      {
+        zb[i] -= block[i + j*bs] * zb[j];
+      }
+    }
+    for(i = n-1; i >= 0; i--)
+    {
+      for(j = i+1; j < n; j++)
+      {
+        zb[i] -= block[i + j*bs] * zb[j];
+      }
+      zb[i] /= block[i + i*bs];
+    }
+  }
+}
+
+/*
+ * preconditioner setup for the iterative linear solvers:
+ * evaluates the iteration matrix dF/dy + cj*dF/dyp on the sparse pattern
+ * with colored finite differences and factorizes the preconditioner.
+ * Memory stays linear in the number of non-zeros.
+ */
+static int preconditionerSetupIDA(double tt, N_Vector yy, N_Vector yp,
+    N_Vector rr, double cj, void *user_data,
+    N_Vector tmp1, N_Vector tmp2, N_Vector tmp3)
+{
+  TRACE_PUSH
+  IDA_SOLVER* idaData = (IDA_SOLVER*)user_data;
+  DATA* data = (DATA*)(((IDA_USERDATA*)idaData->simData)->data);
+  SPARSE_PATTERN* sparsePattern;
+
+  if (idaData->daeMode)
+  {
+    sparsePattern = data->simulationInfo->daeModeData->sparsePattern;
+  }
+  else
+  {
+    sparsePattern = &(data->simulationInfo->analyticJacobians[data->callback->INDEX_JAC_A].sparsePattern);
+  }
+
+  /* the values are stored at the positions of the sparse pattern */
+  if (jacobianSparseNumIDA(tt, yy, yp, rr, idaData->precondJac, cj, user_data))
+  {
+    TRACE_POP
+    return 1;
+  }
+
+  switch (idaData->preconditioner){
+  case IDA_PRECOND_ILU:
+    preconditionerSetupILU(idaData, sparsePattern, idaData->precondJac->data, cj);
+    break;
+  case IDA_PRECOND_BLOCKJACOBI:
+    preconditionerSetupBlockJacobi(idaData, sparsePattern, idaData->precondJac->data, cj);
+    break;
+  default:
+    break;
+  }
+
+  TRACE_POP
+  return 0;
+}
+
+/*
+ * preconditioner solve for the iterative linear solvers: z = P^-1 r
+ */
+static int preconditionerSolveIDA(double tt, N_Vector yy, N_Vector yp,
+    N_Vector rr, N_Vector rvec, N_Vector zvec, double cj, double delta,
+    void *user_data, N_Vector tmp)
+{
+  TRACE_PUSH
+  IDA_SOLVER* idaData = (IDA_SOLVER*)user_data;
+  double *z = N_VGetArrayPointer(zvec);
+
+  memcpy(z, N_VGetArrayPointer(rvec), idaData->N*sizeof(double));
+
+  switch (idaData->preconditioner){
+  case IDA_PRECOND_ILU:
+    preconditionerSolveILU(idaData, z);
+    break;
+  case IDA_PRECOND_BLOCKJACOBI:
+    preconditionerSolveBlockJacobi(idaData, z);
+    break;
+  default:
+    break;
+  }
+
+  TRACE_POP
+  return 0;
+}
+
 #endif
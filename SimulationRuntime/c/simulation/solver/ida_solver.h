@@ -82,6 +82,18 @@ typedef struct IDA_SOLVER
   SlsMat tmpJac;
   DlsMat denseJac;
 
+  /* ### iterative linear solvers ### */
+  int preconditioner;            /* specifies the preconditioner of the iterative linear solvers */
+  SlsMat precondJac;             /* sparse iteration matrix dF/dy + cj*dF/dyp the preconditioner is built from */
+  int *precondRowPtr;            /* ILU(0): factors L and U stored in CSR format */
+  int *precondColIdx;
+  int *precondDiag;              /* ILU(0): position of the diagonal element of each row */
+  int *precondWork;
+  double *precondVal;
+  double *precondBlocks;         /* block Jacobi: LU factors of the diagonal blocks */
+  int *precondPivots;
+  int odeEvaluated;              /* if = 1 the ode is still evaluated at the point of the last jacobian-vector product */
+
   /* ### daeMode ### */
   int daeMode;                  /* if TRUE then solve dae more with a reals residual function */
   long int N;
@@ -96,6 +108,7 @@ typedef struct IDA_SOLVER
   N_Vector* yS;
   N_Vector* ySp;
   N_Vector* ySResult;
+  double* sensParams;            /* values of the sensitivity parameters at the last residual evaluation */
 
 }IDA_SOLVER;
 
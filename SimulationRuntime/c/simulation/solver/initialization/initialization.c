@@ -493,12 +493,14 @@ void initSample(DATA* data, threadData_t *threadData, double startTime, double s
 
   data->callback->function_initSample(data, threadData);              /* set-up sample */
   data->simulationInfo->nextSampleEvent = NAN;  /* should never be reached */
+  heapClear(data->simulationInfo->sampleQueue);
   for(i=0; i<data->modelData->nSamples; ++i) {
     if(startTime < data->modelData->samplesInfo[i].start) {
       data->simulationInfo->nextSampleTimes[i] = data->modelData->samplesInfo[i].start;
     } else {
       data->simulationInfo->nextSampleTimes[i] = data->modelData->samplesInfo[i].start + ceil((startTime-data->modelData->samplesInfo[i].start) / data->modelData->samplesInfo[i].interval) * data->modelData->samplesInfo[i].interval;
     }
+    heapPush(data->simulationInfo->sampleQueue, data->simulationInfo->nextSampleTimes[i], &i);
 
     if((i == 0) || (data->simulationInfo->nextSampleTimes[i] < data->simulationInfo->nextSampleEvent)) {
       data->simulationInfo->nextSampleEvent = data->simulationInfo->nextSampleTimes[i];
@@ -88,6 +88,7 @@ int initializeLinearSystems(DATA *data, threadData_t *threadData)
 
     linsys[i].totalTime = 0;
     linsys[i].failed = 0;
+    linsys[i].numberOfFallbacks = 0;
 
     /* allocate system data */
     linsys[i].x = (double*) malloc(size*sizeof(double));
@@ -264,6 +265,8 @@ void printLinearSystemSolvingStatistics(DATA *data, int sysNumber, int logLevel)
   infoStreamPrint(logLevel, 0, " number of calls                : %ld", linsys[sysNumber].numberOfCall);
   infoStreamPrint(logLevel, 0, " average time per call          : %g", linsys[sysNumber].totalTime/linsys[sysNumber].numberOfCall);
   infoStreamPrint(logLevel, 0, " total time                     : %g", linsys[sysNumber].totalTime);
+  if (linsys[sysNumber].numberOfFallbacks > 0)
+    infoStreamPrint(logLevel, 0, " calls solved by fallback       : %ld", linsys[sysNumber].numberOfFallbacks);
   messageClose(logLevel);
 }
 
@@ -388,7 +391,7 @@ int solve_linear_system(DATA *data, threadData_t *threadData, int sysNumber)
   rt_ext_tp_tick(&(linsys->totalTimeClock));
 
   /* enable to avoid division by zero */
-  data->simulationInfo->noThrowDivZero = 1;
+  threadData->noThrowDivZero = 1;
 
   if(linsys->useSparseSolver == 1)
   {
@@ -486,6 +489,7 @@ int solve_linear_system(DATA *data, threadData_t *threadData, int sysNumber)
         linsys->solverData = defaultSolverData->totalpivotData;
         success = solveTotalPivot(data, threadData, sysNumber);
         linsys->failed = 1;
+        linsys->numberOfFallbacks++;
       }else{
         linsys->failed = 0;
       }
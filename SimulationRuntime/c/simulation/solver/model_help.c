@@ -481,6 +481,21 @@ void printZeroCrossings(DATA *data, int stream)
   TRACE_POP
 }
 
+/*! \fn simulationDataSize
+ *
+ *  Returns the number of bytes of one set of variables, i.e. the amount
+ *  of memory copied by one ring buffer, pre- or old-value copy.
+ *
+ *  \param [in] [mData]
+ */
+static inline unsigned long simulationDataSize(MODEL_DATA *mData)
+{
+  return sizeof(modelica_real)*mData->nVariablesReal
+       + sizeof(modelica_integer)*mData->nVariablesInteger
+       + sizeof(modelica_boolean)*mData->nVariablesBoolean
+       + sizeof(modelica_string)*mData->nVariablesString;
+}
+
 /*! \fn overwriteOldSimulationData
  *
  *  Stores variables (states, derivatives and algebraic) to be used
@@ -497,14 +512,19 @@ void overwriteOldSimulationData(DATA *data)
 {
   TRACE_PUSH
   long i;
+  SIMULATION_DATA *sData = data->localData[0];
+  MODEL_DATA      *mData = data->modelData;
 
+  /* every slot is a copy of the current one; copy from slot 0 directly
+   * instead of chaining slot i-1 into slot i */
   for(i=1; i<ringBufferLength(data->simulationData); ++i)
   {
-    data->localData[i]->timeValue = data->localData[i-1]->timeValue;
-    memcpy(data->localData[i]->realVars, data->localData[i-1]->realVars, sizeof(modelica_real)*data->modelData->nVariablesReal);
-    memcpy(data->localData[i]->integerVars, data->localData[i-1]->integerVars, sizeof(modelica_integer)*data->modelData->nVariablesInteger);
-    memcpy(data->localData[i]->booleanVars, data->localData[i-1]->booleanVars, sizeof(modelica_boolean)*data->modelData->nVariablesBoolean);
-    memcpy(data->localData[i]->stringVars, data->localData[i-1]->stringVars, sizeof(modelica_string)*data->modelData->nVariablesString);
+    data->localData[i]->timeValue = sData->timeValue;
+    memcpy(data->localData[i]->realVars, sData->realVars, sizeof(modelica_real)*mData->nVariablesReal);
+    memcpy(data->localData[i]->integerVars, sData->integerVars, sizeof(modelica_integer)*mData->nVariablesInteger);
+    memcpy(data->localData[i]->booleanVars, sData->booleanVars, sizeof(modelica_boolean)*mData->nVariablesBoolean);
+    memcpy(data->localData[i]->stringVars, sData->stringVars, sizeof(modelica_string)*mData->nVariablesString);
+    data->simulationInfo->callStatistics.copiedBytes += simulationDataSize(mData);
   }
 
   TRACE_POP
@@ -537,9 +557,9 @@ void copyRingBufferSimulationData(DATA *data, threadData_t *threadData, SIMULATI
     memcpy(destData[i]->integerVars, data->localData[i]->integerVars, sizeof(modelica_integer)*data->modelData->nVariablesInteger);
     memcpy(destData[i]->booleanVars, data->localData[i]->booleanVars, sizeof(modelica_boolean)*data->modelData->nVariablesBoolean);
     memcpy(destData[i]->stringVars, data->localData[i]->stringVars, sizeof(modelica_string)*data->modelData->nVariablesString);
+    data->simulationInfo->callStatistics.copiedBytes += simulationDataSize(data->modelData);
   }
 
-
   TRACE_POP
 }
 
@@ -713,6 +733,7 @@ void storeOldValues(DATA *data)
   memcpy(sInfo->integerVarsOld, sData->integerVars, sizeof(modelica_integer)*mData->nVariablesInteger);
   memcpy(sInfo->booleanVarsOld, sData->booleanVars, sizeof(modelica_boolean)*mData->nVariablesBoolean);
   memcpy(sInfo->stringVarsOld, sData->stringVars, sizeof(modelica_string)*mData->nVariablesString);
+  sInfo->callStatistics.copiedBytes += simulationDataSize(mData);
 
   TRACE_POP
 }
@@ -737,6 +758,7 @@ void restoreOldValues(DATA *data)
   memcpy(sData->integerVars, sInfo->integerVarsOld, sizeof(modelica_integer)*mData->nVariablesInteger);
   memcpy(sData->booleanVars, sInfo->booleanVarsOld,  sizeof(modelica_boolean)*mData->nVariablesBoolean);
   memcpy( sData->stringVars, sInfo->stringVarsOld, sizeof(modelica_string)*mData->nVariablesString);
+  sInfo->callStatistics.copiedBytes += simulationDataSize(mData);
 
   TRACE_POP
 }
@@ -760,6 +782,7 @@ void storePreValues(DATA *data)
   memcpy(sInfo->integerVarsPre, sData->integerVars, sizeof(modelica_integer)*mData->nVariablesInteger);
   memcpy(sInfo->booleanVarsPre, sData->booleanVars, sizeof(modelica_boolean)*mData->nVariablesBoolean);
   memcpy(sInfo->stringVarsPre, sData->stringVars, sizeof(modelica_string)*mData->nVariablesString);
+  sInfo->callStatistics.copiedBytes += simulationDataSize(mData);
 
   TRACE_POP
 }
@@ -904,6 +927,9 @@ void initializeDataStruc(DATA *data, threadData_t *threadData)
   data->simulationInfo->nextSampleEvent = data->simulationInfo->startTime;
   data->simulationInfo->nextSampleTimes = (double*) calloc(data->modelData->nSamples, sizeof(double));
   data->simulationInfo->samples = (modelica_boolean*) calloc(data->modelData->nSamples, sizeof(modelica_boolean));
+  data->simulationInfo->sampleQueue = allocHeap(sizeof(long));
+  data->simulationInfo->activeSamples = (long*) calloc(data->modelData->nSamples, sizeof(long));
+  data->simulationInfo->nActiveSamples = 0;
 
   data->modelData->clocksInfo = (CLOCK_INFO*) omc_alloc_interface.malloc_uncollectable(data->modelData->nClocks * sizeof(CLOCK_INFO));
   data->modelData->subClocksInfo = (SUBCLOCK_INFO*) omc_alloc_interface.malloc_uncollectable(data->modelData->nSubClocks * sizeof(SUBCLOCK_INFO));
@@ -919,6 +945,7 @@ void initializeDataStruc(DATA *data, threadData_t *threadData)
   data->simulationInfo->lssMethod = LS_UMFPACK;
   data->simulationInfo->mixedMethod = MIXED_SEARCH;
   data->simulationInfo->newtonStrategy = NEWTON_PURE;
+  data->simulationInfo->newtonJacobianReuse = 0;
   data->simulationInfo->nlsCsvInfomation = 0;
   data->simulationInfo->currentContext = CONTEXT_ALGEBRAIC;
   data->simulationInfo->jacobianEvals = data->modelData->nStates;
@@ -956,6 +983,12 @@ void initializeDataStruc(DATA *data, threadData_t *threadData)
   data->simulationInfo->inputVars = (modelica_real*) calloc(data->modelData->nInputVars, sizeof(modelica_real));
   data->simulationInfo->outputVars = (modelica_real*) calloc(data->modelData->nOutputVars, sizeof(modelica_real));
 
+  /* buffer for the activators of the multi-rate partitions, all partitions are evaluated by default */
+  data->simulationInfo->activators = (modelica_boolean*) malloc(data->modelData->nActivators*sizeof(modelica_boolean));
+  for(i=0; i<data->modelData->nActivators; i++) {
+    data->simulationInfo->activators[i] = 1;
+  }
+
   /* buffer for mixed systems */
   data->simulationInfo->mixedSystemData = (MIXED_SYSTEM_DATA*) omc_alloc_interface.malloc_uncollectable(data->modelData->nMixedSystems*sizeof(MIXED_SYSTEM_DATA));
   data->callback->initialMixedSystem(data->modelData->nMixedSystems, data->simulationInfo->mixedSystemData);
@@ -1002,6 +1035,7 @@ void initializeDataStruc(DATA *data, threadData_t *threadData)
   data->simulationInfo->callStatistics.updateDiscreteSystem = 0;
   data->simulationInfo->callStatistics.functionZeroCrossingsEquations = 0;
   data->simulationInfo->callStatistics.functionZeroCrossings = 0;
+  data->simulationInfo->callStatistics.copiedBytes = 0;
 
   data->simulationInfo->lambda = 1.0;
 
@@ -1011,8 +1045,6 @@ void initializeDataStruc(DATA *data, threadData_t *threadData)
   data->simulationInfo->sampleActivated = 0;
 
   /*  switches used to evaluate the system */
-  data->simulationInfo->solveContinuous = 0;
-  data->simulationInfo->noThrowDivZero = 0;
   data->simulationInfo->discreteCall = 0;
 
   /* initialize model error code */
@@ -1090,6 +1122,8 @@ void deInitializeDataStruc(DATA *data)
   omc_alloc_interface.free_uncollectable(data->modelData->samplesInfo);
   free(data->simulationInfo->nextSampleTimes);
   free(data->simulationInfo->samples);
+  freeHeap(data->simulationInfo->sampleQueue);
+  free(data->simulationInfo->activeSamples);
 
   omc_alloc_interface.free_uncollectable(data->modelData->clocksInfo);
   omc_alloc_interface.free_uncollectable(data->modelData->subClocksInfo);
@@ -1143,6 +1177,9 @@ void deInitializeDataStruc(DATA *data)
   free(data->simulationInfo->inputVars);
   free(data->simulationInfo->outputVars);
 
+  /* free the activators of the multi-rate partitions */
+  free(data->simulationInfo->activators);
+
   /* free external objects buffer */
   free(data->simulationInfo->extObjs);
 
@@ -1239,10 +1276,10 @@ modelica_boolean GreaterEq(double a, double b)
  *
  * Returns the largest integer not greater than x.
  */
-modelica_integer _event_integer(modelica_real x, modelica_integer index, DATA *data)
+modelica_integer _event_integer(modelica_real x, modelica_integer index, DATA *data, threadData_t *threadData)
 {
   modelica_real value;
-  if(data->simulationInfo->discreteCall && !data->simulationInfo->solveContinuous)
+  if(data->simulationInfo->discreteCall && !threadData->solveContinuous)
   {
     data->simulationInfo->mathEventsValuePre[index] = (modelica_integer)floor(x);
   }
@@ -1261,10 +1298,10 @@ modelica_integer _event_integer(modelica_real x, modelica_integer index, DATA *d
  * Returns the largest integer not greater than x.
  * Result and argument shall have type Real.
  */
-modelica_real _event_floor(modelica_real x, modelica_integer index, DATA *data)
+modelica_real _event_floor(modelica_real x, modelica_integer index, DATA *data, threadData_t *threadData)
 {
   modelica_real value;
-  if(data->simulationInfo->discreteCall && !data->simulationInfo->solveContinuous)
+  if(data->simulationInfo->discreteCall && !threadData->solveContinuous)
   {
     data->simulationInfo->mathEventsValuePre[index] = x;
   }
@@ -1283,10 +1320,10 @@ modelica_real _event_floor(modelica_real x, modelica_integer index, DATA *data)
  * Returns the smallest integer not less than x.
  * Result and argument shall have type Real.
  */
-modelica_real _event_ceil(modelica_real x, modelica_integer index, DATA *data)
+modelica_real _event_ceil(modelica_real x, modelica_integer index, DATA *data, threadData_t *threadData)
 {
   modelica_real value;
-  if(data->simulationInfo->discreteCall && !data->simulationInfo->solveContinuous)
+  if(data->simulationInfo->discreteCall && !threadData->solveContinuous)
   {
     data->simulationInfo->mathEventsValuePre[index] = x;
   }
@@ -1305,7 +1342,7 @@ modelica_real _event_ceil(modelica_real x, modelica_integer index, DATA *data)
  */
 modelica_integer _event_mod_integer(modelica_integer x1, modelica_integer x2, modelica_integer index, DATA *data, threadData_t *threadData)
 {
-  if(data->simulationInfo->discreteCall && !data->simulationInfo->solveContinuous)
+  if(data->simulationInfo->discreteCall && !threadData->solveContinuous)
   {
     data->simulationInfo->mathEventsValuePre[index] = (modelica_real)x1;
     data->simulationInfo->mathEventsValuePre[index+1] = (modelica_real)x2;
@@ -1323,7 +1360,7 @@ modelica_integer _event_mod_integer(modelica_integer x1, modelica_integer x2, mo
  */
 modelica_real _event_mod_real(modelica_real x1, modelica_real x2, modelica_integer index, DATA *data, threadData_t *threadData)
 {
-  if(data->simulationInfo->discreteCall && !data->simulationInfo->solveContinuous)
+  if(data->simulationInfo->discreteCall && !threadData->solveContinuous)
   {
     data->simulationInfo->mathEventsValuePre[index] = x1;
     data->simulationInfo->mathEventsValuePre[index+1] = x2;
@@ -1344,7 +1381,7 @@ modelica_real _event_mod_real(modelica_real x1, modelica_real x2, modelica_integ
 modelica_integer _event_div_integer(modelica_integer x1, modelica_integer x2, modelica_integer index, DATA *data, threadData_t *threadData)
 {
   modelica_integer value1, value2;
-  if(data->simulationInfo->discreteCall && !data->simulationInfo->solveContinuous)
+  if(data->simulationInfo->discreteCall && !threadData->solveContinuous)
   {
     data->simulationInfo->mathEventsValuePre[index] = (modelica_real)x1;
     data->simulationInfo->mathEventsValuePre[index+1] = (modelica_real)x2;
@@ -1369,7 +1406,7 @@ modelica_integer _event_div_integer(modelica_integer x1, modelica_integer x2, mo
 modelica_real _event_div_real(modelica_real x1, modelica_real x2, modelica_integer index, DATA *data, threadData_t *threadData)
 {
   modelica_real value1, value2;
-  if(data->simulationInfo->discreteCall && !data->simulationInfo->solveContinuous)
+  if(data->simulationInfo->discreteCall && !threadData->solveContinuous)
   {
     data->simulationInfo->mathEventsValuePre[index] = x1;
     data->simulationInfo->mathEventsValuePre[index+1] = x2;
@@ -44,7 +44,7 @@ extern "C" {
     res = ((op_w)((exp1),(exp2))); \
     data->simulationInfo->relations[index] = res; \
   } \
-  else if(data->simulationInfo->discreteCall == 0 || data->simulationInfo->solveContinuous) \
+  else if(data->simulationInfo->discreteCall == 0 || threadData->solveContinuous) \
   { \
     res = data->simulationInfo->relationsPre[index]; \
   } \
@@ -63,7 +63,7 @@ extern "C" {
     res = ((op_w)((exp1),(exp2))); \
     data->simulationInfo->relations[index] = res; \
   } \
-  else if(data->simulationInfo->discreteCall == 0 || data->simulationInfo->solveContinuous) \
+  else if(data->simulationInfo->discreteCall == 0 || threadData->solveContinuous) \
   { \
     res = data->simulationInfo->relationsPre[index]; \
   } \
@@ -133,9 +133,9 @@ double getNextSampleTimeFMU(DATA *data);
 
 void storeOldValues(DATA *data);
 
-modelica_integer _event_integer(modelica_real x, modelica_integer index, DATA *data);
-modelica_real _event_floor(modelica_real x, modelica_integer index, DATA *data);
-modelica_real _event_ceil(modelica_real x, modelica_integer index, DATA *data);
+modelica_integer _event_integer(modelica_real x, modelica_integer index, DATA *data, threadData_t *threadData);
+modelica_real _event_floor(modelica_real x, modelica_integer index, DATA *data, threadData_t *threadData);
+modelica_real _event_ceil(modelica_real x, modelica_integer index, DATA *data, threadData_t *threadData);
 modelica_integer _event_mod_integer(modelica_integer x1, modelica_integer x2, modelica_integer index, DATA *data, threadData_t *threadData);
 modelica_real _event_mod_real(modelica_real x1, modelica_real x2, modelica_integer index, DATA *data, threadData_t *threadData);
 modelica_integer _event_div_integer(modelica_integer x1, modelica_integer x2, modelica_integer index, DATA *data, threadData_t *threadData);
@@ -50,6 +50,10 @@ extern "C" {
 #include "external_input.h"
 
 
+/* maximal ratio of consecutive residual norms that is accepted before a
+ * reused jacobian is updated */
+#define NEWTON_JACOBIAN_REUSE_RATE 0.5
+
 extern double enorm_(int *n, double *x);
 int solveLinearSystem(int* n, int* iwork, double* fvec, double *fjac, DATA_NEWTON* solverData);
 void calculatingErrors(DATA_NEWTON* solverData, double* delta_x, double* delta_x_scaled, double* delta_f, double* error_f,
@@ -113,9 +117,12 @@ int allocateNewtonData(int size, void** voiddata)
   data->delta_x_vec = (double*) calloc(size,sizeof(double));
 
   data->factorization = 0;
+  data->validFactorization = 0;
   data->calculate_jacobian = 1;
   data->numberOfIterations = 0;
   data->numberOfFunctionEvaluations = 0;
+  data->numberOfJacobianEvaluations = 0;
+  data->numberOfFactorizationsReused = 0;
 
   return 0;
 }
@@ -161,7 +168,8 @@ int freeNewtonData(void **voiddata)
  *				  [calculate_jacobian] flag which decides whether Jacobian is calculated
  *					(0)  once for the first calculation
  * 					(i)  every i steps (=1 means original newton method)
- * 					(-1) never, factorization has to be given in A
+ * 					(-1) never, factorization has to be given in A; the jacobian
+ * 					     is updated if the iteration converges too slowly
  *
  */
 int _omc_newton(int(*f)(int*, double*, double*, void*, int), DATA_NEWTON* solverData, void* userdata)
@@ -228,11 +236,13 @@ int _omc_newton(int(*f)(int*, double*, double*, void*, int), DATA_NEWTON* solver
     {
       (*f)(n, x, fvec, userdata, 0);
       solverData->factorization = 0;
+      solverData->numberOfJacobianEvaluations++;
       calc_jac = solverData->calculate_jacobian;
     }
     else
     {
       solverData->factorization = 1;
+      solverData->numberOfFactorizationsReused++;
       calc_jac--;
     }
 
@@ -300,6 +310,15 @@ int _omc_newton(int(*f)(int*, double*, double*, void*, int), DATA_NEWTON* solver
       /* updating f_old */
       memcpy(solverData->f_old, fvec, *n*sizeof(double));
 
+      /* simplified newton with the factorization of a previous call:
+       * update the jacobian if the residual does not decrease fast enough */
+      if (solverData->calculate_jacobian < 0 && error_f > NEWTON_JACOBIAN_REUSE_RATE * current_fvec_enorm)
+      {
+        infoStreamPrint(LOG_NLS_V, 0, "slow convergence with reused jacobian: update jacobian");
+        solverData->calculate_jacobian = 0;
+        calc_jac = 1;
+      }
+
       current_fvec_enorm = error_f;
 
       /* check if maximum iteration is reached */
@@ -367,6 +386,7 @@ int solveLinearSystem(int* n, int* iwork, double* fvec, double *fjac, DATA_NEWTO
     /* solve J*(x_{n+1} - x_n)=f */
     dgetrf_(n, n, fjac, n, iwork, &lapackinfo);
     solverData->factorization = 1;
+    solverData->validFactorization = (lapackinfo == 0);
     dgetrs_(&trans, n, &nrsh, fjac, n, iwork, fvec, n, &lapackinfo);
   }
   else
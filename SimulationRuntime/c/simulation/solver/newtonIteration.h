@@ -62,8 +62,11 @@ typedef struct DATA_NEWTON
   int* iwork;
   int calculate_jacobian;
   int factorization;
+  int validFactorization; /* fjac and iwork contain the LU factors of a previous call */
   int numberOfIterations; /* over the whole simulation time */
   int numberOfFunctionEvaluations; /* over the whole simulation time */
+  int numberOfJacobianEvaluations; /* over the whole simulation time */
+  int numberOfFactorizationsReused; /* over the whole simulation time */
 
   /* damped newton */
   double* x_new;
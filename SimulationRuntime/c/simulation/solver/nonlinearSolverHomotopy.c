@@ -1113,7 +1113,7 @@ static int newtonAlgorithm(DATA_HOMOTOPY* solverData, double* x)
 
   int assert = 1;
   threadData_t *threadData = solverData->threadData;
-  NONLINEAR_SYSTEM_DATA* nonlinsys = &(solverData->data->simulationInfo->nonlinearSystemData[solverData->data->simulationInfo->currentNonlinearSystemIndex]);
+  NONLINEAR_SYSTEM_DATA* nonlinsys = &(solverData->data->simulationInfo->nonlinearSystemData[solverData->sysNumber]);
 
   /* debug information */
   debugString(LOG_NLS_V, "******************************************************");
@@ -1775,7 +1775,7 @@ int solveHomotopy(DATA *data, threadData_t *threadData, int sysNumber)
     /* evaluate with discontinuities */
     if(data->simulationInfo->discreteCall)
     {
-      ((DATA*)data)->simulationInfo->solveContinuous = 0;
+      threadData->solveContinuous = 0;
     }
     /* evaluate with discontinuities */
  #ifndef OMC_EMCC
@@ -1804,7 +1804,7 @@ int solveHomotopy(DATA *data, threadData_t *threadData, int sysNumber)
         vecCopy(solverData->n, solverData->x0, systemData->nlsx);
         debugVectorDouble(LOG_NLS_V,"Solution", solverData->x0, solverData->n);
 
-        ((DATA*)data)->simulationInfo->solveContinuous = 0;
+        threadData->solveContinuous = 0;
 
         free(relationsPreBackup);
 
@@ -1857,7 +1857,7 @@ int solveHomotopy(DATA *data, threadData_t *threadData, int sysNumber)
         solverData->x0[i] = solverData->xStart[i] + solverData->xScaling[i]*i/solverData->n*0.1;
     }
   }
-  ((DATA*)data)->simulationInfo->solveContinuous = 1;
+  threadData->solveContinuous = 1;
   vecCopy(solverData->n, solverData->x0, solverData->x);
   vecCopy(solverData->n, solverData->f1, solverData->fx0);
   /* start solving loop */
@@ -1905,7 +1905,7 @@ int solveHomotopy(DATA *data, threadData_t *threadData, int sysNumber)
       {
         debugVectorInt(LOG_NLS_V,"Relations Pre vector ", ((DATA*)data)->simulationInfo->relationsPre, ((DATA*)data)->modelData->nRelations);
         debugVectorInt(LOG_NLS_V,"Relations Backup vector ", relationsPreBackup, ((DATA*)data)->modelData->nRelations);
-        ((DATA*)data)->simulationInfo->solveContinuous = 0;
+        threadData->solveContinuous = 0;
         solverData->f(solverData, solverData->x, solverData->f1);
         debugVectorInt(LOG_NLS_V,"Relations vector ", ((DATA*)data)->simulationInfo->relations, ((DATA*)data)->modelData->nRelations);
         if (isNotEqualVectorInt(((DATA*)data)->modelData->nRelations, ((DATA*)data)->simulationInfo->relations, relationsPreBackup)>0)
@@ -1940,7 +1940,7 @@ int solveHomotopy(DATA *data, threadData_t *threadData, int sysNumber)
         vecCopy(solverData->n, solverData->x, systemData->nlsx);
         debugVectorDouble(LOG_NLS_V,"Solution", solverData->x, solverData->n);
         /* reset continous flag */
-        ((DATA*)data)->simulationInfo->solveContinuous = 0;
+        threadData->solveContinuous = 0;
         break;
       }
     }
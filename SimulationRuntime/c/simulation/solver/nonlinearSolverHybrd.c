@@ -312,10 +312,11 @@ static int wrapper_fvec_hybrj(const integer* n, const double* x, double* f, doub
   int i,j;
   struct dataAndSys *dataSys = (struct dataAndSys*) dataAndSysNum;
   DATA *data = (dataSys->data);
-  void *dataAndThreadData[2] = {data, dataSys->threadData};
+  threadData_t *threadData = dataSys->threadData;
+  void *dataAndThreadData[2] = {data, threadData};
   NONLINEAR_SYSTEM_DATA* systemData = &(data->simulationInfo->nonlinearSystemData[dataSys->sysNumber]);
   DATA_HYBRD* solverData = (DATA_HYBRD*)(systemData->solverData);
-  int continuous = data->simulationInfo->solveContinuous;
+  int continuous = threadData->solveContinuous;
 
   switch(*iflag)
   {
@@ -350,7 +351,7 @@ static int wrapper_fvec_hybrj(const integer* n, const double* x, double* f, doub
   case 2:
     /* set residual function continuous for jacobian calculation */
     if(continuous)
-      data->simulationInfo->solveContinuous = 0;
+      threadData->solveContinuous = 0;
 
     if(ACTIVE_STREAM(LOG_NLS_RES))
       infoStreamPrint(LOG_NLS_RES, 0, "-- begin calculating jacobian --");
@@ -387,7 +388,7 @@ static int wrapper_fvec_hybrj(const integer* n, const double* x, double* f, doub
     }
     /* reset residual function again */
     if(continuous)
-      data->simulationInfo->solveContinuous = 1;
+      threadData->solveContinuous = 1;
     break;
 
   default:
@@ -493,9 +494,9 @@ int solveHybrd(DATA *data, threadData_t *threadData, int sysNumber)
     /* set residual function continuous
      */
     if(continuous) {
-      ((DATA*)data)->simulationInfo->solveContinuous = 1;
+      threadData->solveContinuous = 1;
     } else {
-      ((DATA*)data)->simulationInfo->solveContinuous = 0;
+      threadData->solveContinuous = 0;
     }
 
     giveUp = 1;
@@ -561,11 +562,11 @@ int solveHybrd(DATA *data, threadData_t *threadData, int sysNumber)
     /* set residual function continuous */
     if(continuous)
     {
-      ((DATA*)data)->simulationInfo->solveContinuous = 0;
+      threadData->solveContinuous = 0;
     }
     else
     {
-      ((DATA*)data)->simulationInfo->solveContinuous = 1;
+      threadData->solveContinuous = 1;
     }
 
     /* re-scaling x vector */
@@ -588,7 +589,7 @@ int solveHybrd(DATA *data, threadData_t *threadData, int sysNumber)
         if(scaling)
           solverData->useXScaling = 0;
 
-        ((DATA*)data)->simulationInfo->solveContinuous = 0;
+        threadData->solveContinuous = 0;
 
         /* try */
 #ifndef OMC_EMCC
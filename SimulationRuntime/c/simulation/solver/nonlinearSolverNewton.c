@@ -196,6 +196,7 @@ int solveNewton(DATA *data, threadData_t *threadData, int sysNumber)
   int retries = 0;
   int retries2 = 0;
   int nonContinuousCase = 0;
+  int reuseJacobian = 0;
   modelica_boolean *relationsPreBackup = NULL;
   // int casualTearingSet = systemData->strictTearingFunctionCall != NULL;
   int casualTearingSet = data->simulationInfo->nonlinearSystemData[sysNumber].strictTearingFunctionCall != NULL;
@@ -219,8 +220,17 @@ int solveNewton(DATA *data, threadData_t *threadData, int sysNumber)
 
   solverData->nfev = 0;
 
-  /* try to calculate jacobian only once at the beginning of the iteration */
-  solverData->calculate_jacobian = 0;
+  /* try to calculate jacobian only once at the beginning of the iteration
+   * or reuse the factorization of the previous call, but not at events */
+  if(data->simulationInfo->newtonJacobianReuse && solverData->validFactorization && !data->simulationInfo->discreteCall)
+  {
+    reuseJacobian = 1;
+    solverData->calculate_jacobian = -1;
+  }
+  else
+  {
+    solverData->calculate_jacobian = 0;
+  }
 
   /* debug output */
   if(ACTIVE_STREAM(LOG_NLS_V))
@@ -286,6 +296,17 @@ int solveNewton(DATA *data, threadData_t *threadData, int sysNumber)
 
       /* Then try with old values (instead of extrapolating )*/
     }
+    /* the factorization of the previous call did not work, try again with a new jacobian */
+    else if(reuseJacobian)
+    {
+      memcpy(solverData->x, systemData->nlsxExtrapolation, solverData->n*(sizeof(double)));
+      reuseJacobian = 0;
+      giveUp = 0;
+      nfunc_evals += solverData->nfev;
+      infoStreamPrint(LOG_NLS, 0, " - iteration making no progress:\t update reused jacobian.");
+
+      solverData->calculate_jacobian = 0;
+    }
     // If this is the casual tearing set (only exists for dynamic tearing), break after first try
     else if(retries < 1 && casualTearingSet)
     {
@@ -374,9 +395,15 @@ int solveNewton(DATA *data, threadData_t *threadData, int sysNumber)
 
   free(relationsPreBackup);
 
+  /* do not reuse the jacobian of a failed solution process */
+  if(!success)
+    solverData->validFactorization = 0;
+
   /* write statistics */
   systemData->numberOfFEval = solverData->numberOfFunctionEvaluations;
   systemData->numberOfIterations = solverData->numberOfIterations;
+  systemData->numberOfJEval = solverData->numberOfJacobianEvaluations;
+  systemData->numberOfJReuse = solverData->numberOfFactorizationsReused;
 
   return success;
 }
@@ -349,6 +349,8 @@ int initializeNonlinearSystems(DATA *data, threadData_t *threadData)
     size = nonlinsys[i].size;
     nonlinsys[i].numberOfFEval = 0;
     nonlinsys[i].numberOfIterations = 0;
+    nonlinsys[i].numberOfJEval = 0;
+    nonlinsys[i].numberOfJReuse = 0;
 
     /* check if residual function pointer are valid */
     assertStreamPrint(threadData, 0 != nonlinsys[i].residualFunc, "residual function pointer is invalid" );
@@ -544,6 +546,11 @@ void printNonLinearSystemSolvingStatistics(DATA *data, int sysNumber, int logLev
   infoStreamPrint(logLevel, 0, " number of calls                : %ld", nonlinsys[sysNumber].numberOfCall);
   infoStreamPrint(logLevel, 0, " number of iterations           : %ld", nonlinsys[sysNumber].numberOfIterations);
   infoStreamPrint(logLevel, 0, " number of function evaluations : %ld", nonlinsys[sysNumber].numberOfFEval);
+  if (data->simulationInfo->nlsMethod == NLS_NEWTON)
+  {
+    infoStreamPrint(logLevel, 0, " number of jacobian evaluations : %ld", nonlinsys[sysNumber].numberOfJEval);
+    infoStreamPrint(logLevel, 0, " number of reused factorizations: %ld", nonlinsys[sysNumber].numberOfJReuse);
+  }
   infoStreamPrint(logLevel, 0, " average time per call          : %f", nonlinsys[sysNumber].totalTime/nonlinsys[sysNumber].numberOfCall);
   infoStreamPrint(logLevel, 0, " total time                     : %f", nonlinsys[sysNumber].totalTime);
   messageClose(logLevel);
@@ -633,7 +640,7 @@ int updateInnerEquation(void **dataIn, int sysNumber, int discrete)
   /* solve non continuous at discrete points*/
   if(discrete)
   {
-    data->simulationInfo->solveContinuous = 0;
+    threadData->solveContinuous = 0;
   }
 
   /* try */
@@ -660,7 +667,7 @@ int updateInnerEquation(void **dataIn, int sysNumber, int discrete)
 
   if(discrete)
   {
-    data->simulationInfo->solveContinuous = 1;
+    threadData->solveContinuous = 1;
   }
 
   return success;
@@ -681,11 +688,9 @@ int solve_nonlinear_system(DATA *data, threadData_t *threadData, int sysNumber)
   NONLINEAR_SYSTEM_DATA* nonlinsys = &(data->simulationInfo->nonlinearSystemData[sysNumber]);
   struct dataNewtonAndHybrid *mixedSolverData;
 
-  data->simulationInfo->currentNonlinearSystemIndex = sysNumber;
-
   /* enable to avoid division by zero */
-  data->simulationInfo->noThrowDivZero = 1;
-  ((DATA*)data)->simulationInfo->solveContinuous = 1;
+  threadData->noThrowDivZero = 1;
+  threadData->solveContinuous = 1;
 
   /* performance measurement */
   rt_ext_tp_tick(&nonlinsys->totalTimeClock);
@@ -789,8 +794,8 @@ int solve_nonlinear_system(DATA *data, threadData_t *threadData, int sysNumber)
 
 
   /* enable to avoid division by zero */
-  data->simulationInfo->noThrowDivZero = 0;
-  ((DATA*)data)->simulationInfo->solveContinuous = 0;
+  threadData->noThrowDivZero = 0;
+  threadData->solveContinuous = 0;
 
   /* performance measurement and statistics */
   nonlinsys->totalTime += rt_ext_tp_tock(&(nonlinsys->totalTimeClock));
@@ -88,8 +88,12 @@ static int simulationUpdate(DATA* data, threadData_t *threadData, SOLVER_INFO* s
   /***** Event handling *****/
   if (measure_time_flag) rt_tick(SIM_TIMER_EVENT);
 
-  int syncRet = handleTimers(data, threadData, solverInfo);
+  modelica_boolean timerFired;
+  int syncRet = handleTimers(data, threadData, solverInfo, &timerFired);
   int syncRet1;
+  /* pre-values are still valid from prefixedName_updateContinuousSystem
+   * unless variables are changed by events, state selection or clocks */
+  modelica_boolean preValuesValid = !timerFired;
   do
   {
     int eventType = checkEvents(data, threadData, solverInfo->eventLst, !solverInfo->solverRootFinding, /*out*/ &solverInfo->currentTime);
@@ -106,6 +110,7 @@ static int simulationUpdate(DATA* data, threadData_t *threadData, SOLVER_INFO* s
       threadData->currentErrorStage = ERROR_SIMULATION;
       solverInfo->didEventStep = 1;
       overwriteOldSimulationData(data);
+      preValuesValid = 0;
     }
     else /* no event */
     {
@@ -123,16 +128,19 @@ static int simulationUpdate(DATA* data, threadData_t *threadData, SOLVER_INFO* s
       /* if new set is calculated reinit the solver */
       solverInfo->didEventStep = 1;
       overwriteOldSimulationData(data);
+      preValuesValid = 0;
     }
 
     /* Check for warning of variables out of range assert(min<x || x>xmax, ...)*/
     data->callback->checkForAsserts(data, threadData);
 
-    storePreValues(data);
+    if (!preValuesValid)
+      storePreValues(data);
     storeOldValues(data);
 
-    syncRet1 = handleTimers(data, threadData, solverInfo);
+    syncRet1 = handleTimers(data, threadData, solverInfo, NULL);
     syncRet = syncRet1 == 0 ? syncRet : syncRet1;
+    preValuesValid = 0;
   } while (syncRet1);
   return syncRet;
 }
@@ -220,7 +228,10 @@ static void fmtEmitStep(DATA* data, threadData_t *threadData, MEASURE_TIME* mt,
     sim_result.emit(&sim_result, data, threadData);
   }
 #if !defined(OMC_MINIMAL_RUNTIME)
-  embedded_server_update(data->embeddedServerState, data->localData[0]->timeValue);
+  if (data->embeddedServerState) {
+    /* the server records the time it needs to publish the values itself, without the time it is paused */
+    embedded_server_update(data->embeddedServerState, data->localData[0]->timeValue);
+  }
   if (data->real_time_sync.enabled) {
     double time = data->localData[0]->timeValue;
     int64_t res = rt_ext_tp_sync_nanosec(&data->real_time_sync.clock, (uint64_t) (data->real_time_sync.scaling*(time-data->real_time_sync.time)*1e9));
@@ -399,7 +410,13 @@ int prefixedName_performSimulation(DATA* data, threadData_t *threadData, SOLVER_
      * update continuous system
      */
       infoStreamPrint(LOG_SOLVER, 1, "call solver from %g to %g (stepSize: %.15g)", solverInfo->currentTime, solverInfo->currentTime + solverInfo->currentStepSize, solverInfo->currentStepSize);
+      unsigned int stepsBefore = solverInfo->solverStats[0] + solverInfo->solverStatsTmp[0];
       retValIntegrator = simulationStep(data, threadData, solverInfo);
+      /* dassl and ida integrate past the output point and interpolate; count
+       * the output points that did not need an integrator step of their own */
+      if (!syncEventStep && stepsBefore == solverInfo->solverStats[0] + solverInfo->solverStatsTmp[0]) {
+        solverInfo->interpolatedOutputs++;
+      }
       infoStreamPrint(LOG_SOLVER, 0, "finished solver step %g", solverInfo->currentTime);
       messageClose(LOG_SOLVER);
 
@@ -38,6 +38,9 @@
 void omc_real_time_sync_init(threadData_t *threadData, DATA *data)
 {
   data->real_time_sync.maxLate = INT64_MIN;
+  data->real_time_sync.maxServerUpdate = 0;
+  data->real_time_sync.totalServerUpdate = 0;
+  data->real_time_sync.nServerUpdates = 0;
 
   omc_real_time_sync_update(data, data->real_time_sync.scaling);
 
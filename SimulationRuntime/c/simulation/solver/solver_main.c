@@ -32,6 +32,7 @@
  */
 
 #include "omc_config.h"
+#include <inttypes.h>
 #include "simulation/simulation_runtime.h"
 #include "simulation/results/simulation_result.h"
 #include "solver_main.h"
@@ -79,9 +80,23 @@ typedef struct RK4_DATA
   double *c;
 }RK4_DATA;
 
+typedef struct MULTIRATE_DATA
+{
+  double *x0;                        /* states at the start of the latent step */
+  double *x1;                        /* states at the end of the latent step */
+  double *xa;                        /* states at the start of the active step */
+  double *k1;                        /* derivatives at the start of the current step */
+  double *scaledError;               /* local error of each state divided by its tolerance */
+  modelica_boolean *activeStates;    /* =1 the state is integrated in the active steps */
+  double t0;
+  double t1;
+  double activeStepSize;             /* last step size of the active steps, 0 if there was none */
+}MULTIRATE_DATA;
+
 
 static int euler_ex_step(DATA* data, SOLVER_INFO* solverInfo);
 static int rungekutta_step(DATA* data, threadData_t *threadData, SOLVER_INFO* solverInfo);
+static int multirate_step(DATA* data, threadData_t *threadData, SOLVER_INFO* solverInfo);
 static int sym_euler_im_step(DATA* data, threadData_t *threadData, SOLVER_INFO* solverInfo);
 
 static int radau_lobatto_step(DATA* data, SOLVER_INFO* solverInfo);
@@ -112,6 +127,12 @@ int solver_main_step(DATA* data, threadData_t *threadData, SOLVER_INFO* solverIn
       data->simulationInfo->solverSteps = solverInfo->solverStats[0] + solverInfo->solverStatsTmp[0];
     TRACE_POP
     return retVal;
+  case S_MULTIRATE:
+    retVal = multirate_step(data, threadData, solverInfo);
+    if(omc_flag[FLAG_SOLVER_STEPS])
+      data->simulationInfo->solverSteps = solverInfo->solverStats[0] + solverInfo->solverStatsTmp[0];
+    TRACE_POP
+    return retVal;
 
 #if !defined(OMC_MINIMAL_RUNTIME)
   case S_DASSL:
@@ -196,6 +217,7 @@ int initializeSolverData(DATA* data, threadData_t *threadData, SOLVER_INFO* solv
   solverInfo->didEventStep = 0;
   solverInfo->stateEvents = 0;
   solverInfo->sampleEvents = 0;
+  solverInfo->interpolatedOutputs = 0;
   solverInfo->solverStats = (unsigned int*) calloc(numStatistics, sizeof(unsigned int));
   solverInfo->solverStatsTmp = (unsigned int*) calloc(numStatistics, sizeof(unsigned int));
 
@@ -248,6 +270,23 @@ int initializeSolverData(DATA* data, threadData_t *threadData, SOLVER_INFO* solv
     solverInfo->solverData = rungeData;
     break;
   }
+  case S_MULTIRATE:
+  {
+    /* Allocate multi-rate work arrays */
+    MULTIRATE_DATA* multirateData = (MULTIRATE_DATA*) malloc(sizeof(MULTIRATE_DATA));
+    multirateData->x0 = (double*) calloc(data->modelData->nStates, sizeof(double));
+    multirateData->x1 = (double*) calloc(data->modelData->nStates, sizeof(double));
+    multirateData->xa = (double*) calloc(data->modelData->nStates, sizeof(double));
+    multirateData->k1 = (double*) calloc(data->modelData->nStates, sizeof(double));
+    multirateData->scaledError = (double*) calloc(data->modelData->nStates, sizeof(double));
+    multirateData->activeStates = (modelica_boolean*) calloc(data->modelData->nStates, sizeof(modelica_boolean));
+    multirateData->activeStepSize = 0.0;
+    if (data->modelData->nActivators == 0) {
+      infoStreamPrint(LOG_SOLVER, 0, "The ode equations are not partitioned, the active steps evaluate all of them. Use the compiler flag -d=multirate.");
+    }
+    solverInfo->solverData = multirateData;
+    break;
+  }
   case S_QSS: break;
 #if !defined(OMC_MINIMAL_RUNTIME)
   case S_DASSL:
@@ -365,6 +404,18 @@ int freeSolverData(DATA* data, SOLVER_INFO* solverInfo)
     free(((RK4_DATA*)(solverInfo->solverData))->work_states);
     free((RK4_DATA*)solverInfo->solverData);
   }
+  else if(solverInfo->solverMethod == S_MULTIRATE)
+  {
+    /* free multi-rate work arrays */
+    MULTIRATE_DATA* multirateData = (MULTIRATE_DATA*)solverInfo->solverData;
+    free(multirateData->x0);
+    free(multirateData->x1);
+    free(multirateData->xa);
+    free(multirateData->k1);
+    free(multirateData->scaledError);
+    free(multirateData->activeStates);
+    free(multirateData);
+  }
 #if !defined(OMC_MINIMAL_RUNTIME)
   else if(solverInfo->solverMethod == S_DASSL)
   {
@@ -584,6 +635,8 @@ int finishSimulation(DATA* data, threadData_t *threadData, SOLVER_INFO* solverIn
       infoStreamPrint(LOG_STATS, 0, "%5d evaluations of jacobian", solverInfo->solverStats[2]);
       infoStreamPrint(LOG_STATS, 0, "%5d error test failures", solverInfo->solverStats[3]);
       infoStreamPrint(LOG_STATS, 0, "%5d convergence test failures", solverInfo->solverStats[4]);
+      if (S_DASSL == solverInfo->solverMethod || S_IDA == solverInfo->solverMethod)
+        infoStreamPrint(LOG_STATS, 0, "%5ld output points interpolated without an own step", solverInfo->interpolatedOutputs);
       messageClose(LOG_STATS);
     }
 
@@ -601,6 +654,12 @@ int finishSimulation(DATA* data, threadData_t *threadData, SOLVER_INFO* solverIn
     infoStreamPrint(LOG_STATS_V, 0, "%5ld calls of functionZeroCrossings", data->simulationInfo->callStatistics.functionZeroCrossings);
     messageClose(LOG_STATS_V);
 
+    infoStreamPrint(LOG_STATS_V, 1, "simulation data");
+    infoStreamPrint(LOG_STATS_V, 0, "%5" PRIu64 " bytes copied between ring buffer, pre- and old-values", data->simulationInfo->callStatistics.copiedBytes);
+    if (solverInfo->solverStats[0] > 0)
+      infoStreamPrint(LOG_STATS_V, 0, "%5.0f bytes copied per step", (double)data->simulationInfo->callStatistics.copiedBytes / solverInfo->solverStats[0]);
+    messageClose(LOG_STATS_V);
+
     infoStreamPrint(LOG_STATS_V, 1, "linear systems");
     for(ui=0; ui<data->modelData->nLinearSystems; ui++)
       printLinearSystemSolvingStatistics(data, ui, LOG_STATS_V);
@@ -761,6 +820,12 @@ int solver_main(DATA* data, threadData_t *threadData, const char* init_initMetho
     infoStreamPrint(LOG_RT, 0, "Maximum real-time latency was (positive=missed dealine, negative is slack): %d %s", tMaxLate, unit);
   }
 #if !defined(OMC_MINIMAL_RUNTIME)
+  if (data->embeddedServerState && data->real_time_sync.nServerUpdates > 0) {
+    int tMax=0, tAvg=0;
+    const char *unitMax = prettyPrintNanoSec(data->real_time_sync.maxServerUpdate, &tMax);
+    const char *unitAvg = prettyPrintNanoSec(data->real_time_sync.totalServerUpdate / data->real_time_sync.nServerUpdates, &tAvg);
+    infoStreamPrint(LOG_RT, 0, "Embedded server updates: %ld, average %d %s, maximum %d %s", data->real_time_sync.nServerUpdates, tAvg, unitAvg, tMax, unitMax);
+  }
   embedded_server_deinit(data->embeddedServerState);
   embedded_server_unload_functions(dllHandle);
 #endif
@@ -890,6 +955,165 @@ static int rungekutta_step(DATA* data, threadData_t *threadData, SOLVER_INFO* so
   return 0;
 }
 
+/***************************************    MULTIRATE     ***********************************/
+/* The latent step integrates all states with the full step size. The states
+ * that miss the tolerance are integrated again in active steps of adaptive
+ * size, in which functionODE only evaluates the partitions of their
+ * activators and the other states are interpolated linearly between the start
+ * and the end of the latent step. */
+
+static void multirate_interpolate(DATA* data, MULTIRATE_DATA* mr, double t)
+{
+  int i;
+  modelica_real *states = data->localData[0]->realVars;
+  double s = (t - mr->t0) / (mr->t1 - mr->t0);
+
+  for(i = 0; i < data->modelData->nStates; i++)
+  {
+    if(!mr->activeStates[i])
+    {
+      states[i] = mr->x0[i] + s * (mr->x1[i] - mr->x0[i]);
+    }
+  }
+}
+
+static void multirate_evalODE(DATA* data, threadData_t *threadData, double t)
+{
+  data->localData[0]->timeValue = t;
+  /* read input vars */
+  externalInputUpdate(data);
+  data->callback->input_function(data, threadData);
+  /* eval ode equations */
+  data->callback->functionODE(data, threadData);
+}
+
+/* Explicit Euler step from the states x at time t, corrected with Heun's
+ * method, for the given states or all of them if activeStates is NULL. k1
+ * holds the derivatives at (t, x). Returns the number of states whose
+ * difference between both methods exceeds the tolerance. */
+static int multirate_heunStep(DATA* data, threadData_t *threadData, MULTIRATE_DATA* mr, const double *x, double t, double h, const modelica_boolean *activeStates)
+{
+  int i, nErrors = 0;
+  modelica_real *states = data->localData[0]->realVars;
+  modelica_real *stateDer = states + data->modelData->nStates;
+  double tol = data->simulationInfo->tolerance;
+
+  for(i = 0; i < data->modelData->nStates; i++)
+  {
+    if(!activeStates || activeStates[i])
+    {
+      states[i] = x[i] + h * mr->k1[i];
+    }
+  }
+  if(activeStates)
+  {
+    multirate_interpolate(data, mr, t + h);
+  }
+  multirate_evalODE(data, threadData, t + h);
+
+  for(i = 0; i < data->modelData->nStates; i++)
+  {
+    if(!activeStates || activeStates[i])
+    {
+      states[i] = x[i] + 0.5 * h * (mr->k1[i] + stateDer[i]);
+      mr->scaledError[i] = 0.5 * h * fabs(stateDer[i] - mr->k1[i]) / (tol * (1.0 + fmax(fabs(x[i]), fabs(states[i]))));
+      if(mr->scaledError[i] > 1.0)
+      {
+        nErrors++;
+      }
+    }
+  }
+  return nErrors;
+}
+
+static int multirate_step(DATA* data, threadData_t *threadData, SOLVER_INFO* solverInfo)
+{
+  MULTIRATE_DATA *mr = (MULTIRATE_DATA*)solverInfo->solverData;
+  SIMULATION_DATA *sData = (SIMULATION_DATA*)data->localData[0];
+  SIMULATION_DATA *sDataOld = (SIMULATION_DATA*)data->localData[1];
+  MODEL_DATA *mData = data->modelData;
+  modelica_boolean *activators = data->simulationInfo->activators;
+  modelica_real* stateDer = sData->realVars + mData->nStates;
+  size_t stateSize = mData->nStates * sizeof(double);
+  double h = solverInfo->currentStepSize, ha, t;
+  int i, nErrors, nActive = 0, nAccepted = 0;
+
+  mr->t0 = sDataOld->timeValue;
+  mr->t1 = sDataOld->timeValue + h;
+  solverInfo->currentTime = mr->t1;
+
+  /* latent step */
+  memcpy(mr->x0, sDataOld->realVars, stateSize);
+  memcpy(mr->k1, sDataOld->realVars + mData->nStates, stateSize);
+  nErrors = multirate_heunStep(data, threadData, mr, mr->x0, mr->t0, h, NULL);
+  solverInfo->solverStatsTmp[0] += 1;
+  solverInfo->solverStatsTmp[1] += 1;
+
+  if(nErrors > 0)
+  {
+    memcpy(mr->x1, sData->realVars, stateSize);
+    for(i = 0; i < mData->nActivators; i++)
+    {
+      activators[i] = 0;
+    }
+    for(i = 0; i < mData->nStates; i++)
+    {
+      mr->activeStates[i] = mr->scaledError[i] > 1.0;
+      if(mr->activeStates[i])
+      {
+        nActive++;
+        if(mData->nActivators > 0)
+        {
+          activators[mData->stateActivator[i]] = 1;
+        }
+      }
+    }
+    infoStreamPrint(LOG_SOLVER, 0, "multirate: %d of %ld states take active steps in [%g, %g]", nActive, (long)mData->nStates, mr->t0, mr->t1);
+
+    /* active steps, the derivatives at the start are the ones of the latent step */
+    memcpy(mr->xa, mr->x0, stateSize);
+    ha = (mr->activeStepSize > 0.0 && mr->activeStepSize < h) ? mr->activeStepSize : 0.5 * h;
+    t = mr->t0;
+    while(mr->t1 - t > 1e-10 * h)
+    {
+      nErrors = multirate_heunStep(data, threadData, mr, mr->xa, t, fmin(ha, mr->t1 - t), mr->activeStates);
+      solverInfo->solverStatsTmp[1] += 1;
+      if(nErrors > 0 && ha > 1e-6 * h)
+      {
+        ha = 0.5 * ha;
+        nAccepted = 0;
+        continue;
+      }
+      t += fmin(ha, mr->t1 - t);
+      memcpy(mr->xa, sData->realVars, stateSize);
+      solverInfo->solverStatsTmp[0] += 1;
+      if(++nAccepted == 4)
+      {
+        ha = 2.0 * ha;
+        nAccepted = 0;
+      }
+      if(mr->t1 - t > 1e-10 * h)
+      {
+        multirate_evalODE(data, threadData, t);
+        memcpy(mr->k1, stateDer, stateSize);
+        solverInfo->solverStatsTmp[1] += 1;
+      }
+    }
+    mr->activeStepSize = ha;
+
+    /* the latent states end with the solution of the latent step, and
+     * functionODE evaluates all partitions again */
+    multirate_interpolate(data, mr, mr->t1);
+    for(i = 0; i < mData->nActivators; i++)
+    {
+      activators[i] = 1;
+    }
+  }
+  sData->timeValue = solverInfo->currentTime;
+
+  return 0;
+}
+
 /***************************************    Run Ipopt for optimization     ***********************************/
 #if defined(WITH_IPOPT)
 static int ipopt_step(DATA* data, threadData_t *threadData, SOLVER_INFO* solverInfo)
@@ -68,6 +68,7 @@ typedef struct SOLVER_INFO
   /* stats */
   unsigned long stateEvents;
   unsigned long sampleEvents;
+  unsigned long interpolatedOutputs; /* output points reached without an own integrator step */
   /* integrator stats */
   unsigned int* solverStats;
   unsigned int* solverStatsTmp;
@@ -42,7 +42,7 @@ void initSynchronous(DATA* data, threadData_t *threadData, modelica_real startTi
   TRACE_PUSH
 
   data->callback->function_initSynchronous(data, threadData);
-  data->simulationInfo->intvlTimers = allocList(sizeof(SYNC_TIMER));
+  data->simulationInfo->intvlTimers = allocHeap(sizeof(SYNC_TIMER));
   long i;
 
   for(i=0; i<data->modelData->nClocks; i++)
@@ -52,7 +52,7 @@ void initSynchronous(DATA* data, threadData_t *threadData, modelica_real startTi
       timer.idx = i;
       timer.type = SYNC_BASE_CLOCK;
       timer.activationTime = startTime;
-      listPushFront(data->simulationInfo->intvlTimers, &timer);
+      heapPush(data->simulationInfo->intvlTimers, timer.activationTime, &timer);
     }
   }
 
@@ -64,42 +64,12 @@ void initSynchronous(DATA* data, threadData_t *threadData, modelica_real startTi
 }
 
 #if !defined(OMC_MINIMAL_RUNTIME)
-static void insertTimer(LIST* list, SYNC_TIMER* timer)
-{
-  TRACE_PUSH
-
-  LIST_NODE* prevNode = NULL;
-  if(listLen(list) > 0)
-  {
-    LIST_NODE* tmpNode = listFirstNode(list);
-    SYNC_TIMER* tmpTimer = listNodeData(tmpNode);
-    assertStreamPrint(NULL, 0 != tmpTimer, "invalid timerList node");
-
-    while(tmpTimer->activationTime <= timer->activationTime)
-    {
-      prevNode = tmpNode;
-      tmpNode = listNextNode(tmpNode);
-      if(tmpNode)
-      {
-        tmpTimer = listNodeData(tmpNode);
-        assertStreamPrint(NULL, 0 != tmpTimer, "invalid timerList node");
-      }
-      else break;
-    }
-  }
-  if (prevNode) listInsert(list, prevNode, timer);
-  else listPushFront(list, timer);
-
-  TRACE_POP
-}
-
-
 void checkForSynchronous(DATA *data, SOLVER_INFO* solverInfo)
 {
   TRACE_PUSH
-  if (listLen(data->simulationInfo->intvlTimers) > 0)
+  if (heapLen(data->simulationInfo->intvlTimers) > 0)
   {
-    SYNC_TIMER* nextTimer = (SYNC_TIMER*)listNodeData(listFirstNode(data->simulationInfo->intvlTimers));
+    SYNC_TIMER* nextTimer = (SYNC_TIMER*)heapTopData(data->simulationInfo->intvlTimers);
     double nextTimeStep = solverInfo->currentTime + solverInfo->currentStepSize;
 
     if ((nextTimer->activationTime <= nextTimeStep + SYNC_EPS) && (nextTimer->activationTime >= solverInfo->currentTime))
@@ -155,7 +125,7 @@ void fireClock(DATA* data, threadData_t *threadData, long idx, double curTime)
       nextTimer.idx = i + off;
       nextTimer.type = SYNC_SUB_CLOCK;
       nextTimer.activationTime = next_time;
-      insertTimer(data->simulationInfo->intvlTimers, &nextTimer);
+      heapPush(data->simulationInfo->intvlTimers, nextTimer.activationTime, &nextTimer);
     }
   }
   TRACE_POP
@@ -172,7 +142,7 @@ static void handleBaseClock(DATA* data, threadData_t *threadData, long idx, doub
   timer.idx = idx;
   timer.type = SYNC_BASE_CLOCK;
   timer.activationTime = curTime + clkData->interval;;
-  insertTimer(data->simulationInfo->intvlTimers, &timer);
+  heapPush(data->simulationInfo->intvlTimers, timer.activationTime, &timer);
 
   clkData->timepoint = curTime;
   clkData->cnt++;
@@ -184,21 +154,29 @@ static void handleBaseClock(DATA* data, threadData_t *threadData, long idx, doub
   * Return 0, if there is no fired timers;
            1, if there is a fired timer;
            2, if there is a fired timer which trigger event;
+  * Base clocks do not count as fired timers for the return value, but they
+  * update the clocked variables; timerFired (if not NULL) is set if any timer
+  * was handled.
 */
-int handleTimers(DATA* data, threadData_t *threadData, SOLVER_INFO* solverInfo)
+int handleTimers(DATA* data, threadData_t *threadData, SOLVER_INFO* solverInfo, modelica_boolean *timerFired)
 {
   TRACE_PUSH
   int ret = 0;
 
-  if (listLen(data->simulationInfo->intvlTimers) > 0)
+  if (timerFired)
+    *timerFired = 0;
+
+  if (heapLen(data->simulationInfo->intvlTimers) > 0)
   {
-    SYNC_TIMER* nextTimer = (SYNC_TIMER*)listNodeData(listFirstNode(data->simulationInfo->intvlTimers));
+    SYNC_TIMER* nextTimer = (SYNC_TIMER*)heapTopData(data->simulationInfo->intvlTimers);
     while(nextTimer->activationTime <= solverInfo->currentTime + SYNC_EPS)
     {
       long idx =  nextTimer->idx;
       double activationTime = nextTimer->activationTime;
       SYNC_TIMER_TYPE type = nextTimer->type;
-      listPopFront(data->simulationInfo->intvlTimers);
+      heapPop(data->simulationInfo->intvlTimers);
+      if (timerFired)
+        *timerFired = 1;
       switch(type)
       {
         case SYNC_BASE_CLOCK:
@@ -213,8 +191,8 @@ int handleTimers(DATA* data, threadData_t *threadData, SOLVER_INFO* solverInfo)
             ret = ret == 2 ? ret : 1;
           break;
       }
-      if (listLen(data->simulationInfo->intvlTimers) == 0) break;
-      nextTimer = (SYNC_TIMER*)listNodeData(listFirstNode(data->simulationInfo->intvlTimers));
+      if (heapLen(data->simulationInfo->intvlTimers) == 0) break;
+      nextTimer = (SYNC_TIMER*)heapTopData(data->simulationInfo->intvlTimers);
     }
   }
 
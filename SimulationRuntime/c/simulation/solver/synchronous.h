@@ -36,7 +36,7 @@
 
 #include "simulation_data.h"
 #include "simulation/solver/solver_main.h"
-#include "util/list.h"
+#include "util/heap.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -56,7 +56,7 @@ typedef struct SYNC_TIMER {
 void initSynchronous(DATA* data, threadData_t *threadData, modelica_real startTime);
 void checkForSynchronous(DATA *data, SOLVER_INFO* solverInfo);
 void fireClock(DATA* data, threadData_t *threadData, long idx, double curTime);
-int handleTimers(DATA *data, threadData_t *threadData, SOLVER_INFO* solverInfo);
+int handleTimers(DATA *data, threadData_t *threadData, SOLVER_INFO* solverInfo, modelica_boolean *timerFired);
 
 
 #ifdef __cplusplus
@@ -43,6 +43,7 @@
 #include "util/rtclock.h"
 #include "util/rational.h"
 #include "util/list.h"
+#include "util/heap.h"
 
 #define omc_dummyVarInfo {-1,-1,"","",omc_dummyFileInfo}
 #define omc_dummyEquationInfo {-1,0,"",-1,NULL}
@@ -108,6 +109,7 @@ typedef struct CALL_STATISTICS
   long functionZeroCrossingsEquations;
   long functionZeroCrossings;
   long functionEvalDAE;
+  uint64_t copiedBytes;                /* bytes copied between ring buffer, pre- and old-values */
 } CALL_STATISTICS;
 
 typedef enum {ERROR_AT_TIME,NO_PROGRESS_START_POINT,NO_PROGRESS_FACTOR,IMPROPER_INPUT} equationSystemError;
@@ -292,6 +294,8 @@ typedef struct NONLINEAR_SYSTEM_DATA
   unsigned long numberOfCall;           /* number of solving calls of this system */
   unsigned long numberOfFEval;          /* number of function evaluations of this system */
   unsigned long numberOfIterations;     /* number of iteration of non-linear solvers of this system */
+  unsigned long numberOfJEval;          /* number of jacobian evaluations of this system */
+  unsigned long numberOfJReuse;         /* number of iterations that reused an existing factorization of the jacobian */
   double totalTime;                     /* save the totalTime */
   rtclock_t totalTimeClock;             /* time clock for the totalTime  */
   void* csvData;                        /* information to save csv data */
@@ -337,6 +341,7 @@ typedef struct LINEAR_SYSTEM_DATA
 
   /* statistics */
   unsigned long numberOfCall;           /* number of solving calls of this system */
+  unsigned long numberOfFallbacks;      /* number of calls solved by the fallback solver */
   double totalTime;                     /* save the totalTime */
   rtclock_t totalTimeClock;             /* time clock for the totalTime  */
 }LINEAR_SYSTEM_DATA;
@@ -510,6 +515,9 @@ typedef struct MODEL_DATA
 
   long nSensitivityVars;
   long nSensitivityParamVars;
+
+  long nActivators;                    /* number of activators of the multi-rate partitions of the ode equations, 0 if they are not partitioned */
+  const int* stateActivator;           /* activator of the partitions each state depends on */
 }MODEL_DATA;
 
 typedef struct CLOCK_DATA {
@@ -546,6 +554,7 @@ typedef struct SIMULATION_INFO
   int mixedMethod;                     /* mixed solver */
   int nlsMethod;                       /* nonlinear solver */
   int newtonStrategy;                  /* newton damping strategy solver */
+  int newtonJacobianReuse;             /* = 1 newton solver reuses the factorized jacobian across calls */
   int nlsCsvInfomation;                /* = 1 csv files with detailed nonlinear solver process are generated */
 
   /* current context evaluation, set by dassl and used for extrapolation
@@ -564,8 +573,6 @@ typedef struct SIMULATION_INFO
   modelica_boolean needToIterate;      /* =1 if reinit has been activated, iteration about the system is needed */
   modelica_boolean simulationSuccess;  /* =0 the simulation run successful, otherwise an error code is set */
   modelica_boolean sampleActivated;    /* =1 a sample expresion if going to be actived, 0 otherwise */
-  modelica_boolean solveContinuous;    /* =1 during the continuous integration to avoid zero-crossings jumps,  0 otherwise. */
-  modelica_boolean noThrowDivZero;     /* =1 if solving nonlinear system to avoid THROW for division by zero,  0 otherwise. */
 
   double solverSteps;                  /* Number of integration steps so far for writing to the result file*/
 
@@ -574,8 +581,11 @@ typedef struct SIMULATION_INFO
   double nextSampleEvent;              /* point in time of next sample-call */
   double *nextSampleTimes;             /* array of next sample time */
   modelica_boolean *samples;           /* array of the current value for all sample-calls */
+  HEAP* sampleQueue;                   /* indices of all sample-calls ordered by nextSampleTimes */
+  long* activeSamples;                 /* indices of the sample-calls activated by the current time event */
+  long nActiveSamples;
 
-  LIST* intvlTimers;
+  HEAP* intvlTimers;                   /* SYNC_TIMER ordered by activation time */
   CLOCK_DATA *clocksData;
 
   modelica_real* zeroCrossings;
@@ -608,16 +618,16 @@ typedef struct SIMULATION_INFO
   modelica_real* outputVars;
   EXTERNAL_INPUT external_input;
 
+  modelica_boolean* activators;        /* =1 functionODE evaluates the partitions of the activator, =0 they keep their last values */
+
   modelica_real* sensitivityMatrix;    /* used by integrator for sensitivity mode  */
   int* sensitivityParList;             /* used by integrator for sensitivity mode  */
 
   ANALYTIC_JACOBIAN* analyticJacobians;
 
   NONLINEAR_SYSTEM_DATA* nonlinearSystemData;
-  int currentNonlinearSystemIndex;
 
   LINEAR_SYSTEM_DATA* linearSystemData;
-  int currentLinearSystemIndex;
 
   MIXED_SYSTEM_DATA* mixedSystemData;
 
@@ -655,6 +665,9 @@ typedef struct {
   double time;
   rtclock_t clock;
   int64_t maxLate;
+  int64_t maxServerUpdate;   /* longest update of the embedded server, without pauses (nanoseconds) */
+  int64_t totalServerUpdate; /* total time of the embedded server updates, without pauses (nanoseconds) */
+  long nServerUpdates;
 } real_time_sync_t;
 #endif
 
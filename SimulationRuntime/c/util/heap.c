@@ -0,0 +1,183 @@
+/*
+ * This file is part of OpenModelica.
+ *
+ * Copyright (c) 1998-2014, Open Source Modelica Consortium (OSMC),
+ * c/o Linköpings universitet, Department of Computer and Information Science,
+ * SE-58183 Linköping, Sweden.
+ *
+ * All rights reserved.
+ *
+ * THIS PROGRAM IS PROVIDED UNDER THE TERMS OF THE BSD NEW LICENSE OR THE
+ * GPL VERSION 3 LICENSE OR THE OSMC PUBLIC LICENSE (OSMC-PL) VERSION 1.2.
+ * ANY USE, REPRODUCTION OR DISTRIBUTION OF THIS PROGRAM CONSTITUTES
+ * RECIPIENT'S ACCEPTANCE OF THE OSMC PUBLIC LICENSE OR THE GPL VERSION 3,
+ * ACCORDING TO RECIPIENTS CHOICE.
+ *
+ * The OpenModelica software and the OSMC (Open Source Modelica Consortium)
+ * Public License (OSMC-PL) are obtained from OSMC, either from the above
+ * address, from the URLs: http://www.openmodelica.org or
+ * http://www.ida.liu.se/projects/OpenModelica, and in the OpenModelica
+ * distribution. GNU version 3 is obtained from:
+ * http://www.gnu.org/copyleft/gpl.html. The New BSD License is obtained from:
+ * http://www.opensource.org/licenses/BSD-3-Clause.
+ *
+ * This program is distributed WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE, EXCEPT AS
+ * EXPRESSLY SET FORTH IN THE BY RECIPIENT SELECTED SUBSIDIARY LICENSE
+ * CONDITIONS OF OSMC-PL.
+ *
+ */
+
+/*! \file heap.c
+ *
+ * Description: This file is a C source file for the simulation runtime.
+ * It contains a binary min-heap ordered by a real key.
+ */
+
+#include "heap.h"
+#include "omc_error.h"
+
+#include <memory.h>
+#include <stdlib.h>
+
+typedef struct HEAP_KEY
+{
+  double key;
+  unsigned long seq;      /* insertion order, breaks ties between equal keys */
+} HEAP_KEY;
+
+struct HEAP
+{
+  HEAP_KEY *keys;
+  char *data;
+  char *tmp;              /* scratch item used while swapping */
+  unsigned int itemSize;
+  unsigned int length;
+  unsigned int capacity;
+  unsigned long seq;
+};
+
+static inline int heapLess(const HEAP_KEY *a, const HEAP_KEY *b)
+{
+  return a->key < b->key || (a->key == b->key && a->seq < b->seq);
+}
+
+static inline void heapSwap(HEAP *heap, unsigned int i, unsigned int j)
+{
+  HEAP_KEY key = heap->keys[i];
+  heap->keys[i] = heap->keys[j];
+  heap->keys[j] = key;
+
+  memcpy(heap->tmp, heap->data + i*heap->itemSize, heap->itemSize);
+  memcpy(heap->data + i*heap->itemSize, heap->data + j*heap->itemSize, heap->itemSize);
+  memcpy(heap->data + j*heap->itemSize, heap->tmp, heap->itemSize);
+}
+
+HEAP *allocHeap(unsigned int itemSize)
+{
+  HEAP *heap = (HEAP*)malloc(sizeof(HEAP));
+  assertStreamPrint(NULL, 0 != heap, "out of memory");
+
+  heap->capacity = 16;
+  heap->keys = (HEAP_KEY*)malloc(heap->capacity*sizeof(HEAP_KEY));
+  heap->data = (char*)malloc(heap->capacity*itemSize);
+  heap->tmp = (char*)malloc(itemSize);
+  assertStreamPrint(NULL, 0 != heap->keys && 0 != heap->data && 0 != heap->tmp, "out of memory");
+
+  heap->itemSize = itemSize;
+  heap->length = 0;
+  heap->seq = 0;
+
+  return heap;
+}
+
+void freeHeap(HEAP *heap)
+{
+  if(heap)
+  {
+    free(heap->keys);
+    free(heap->data);
+    free(heap->tmp);
+    free(heap);
+  }
+}
+
+void heapPush(HEAP *heap, double key, const void *data)
+{
+  unsigned int i, parent;
+  assertStreamPrint(NULL, 0 != heap, "invalid heap-pointer");
+
+  if(heap->length == heap->capacity)
+  {
+    heap->capacity *= 2;
+    heap->keys = (HEAP_KEY*)realloc(heap->keys, heap->capacity*sizeof(HEAP_KEY));
+    heap->data = (char*)realloc(heap->data, heap->capacity*heap->itemSize);
+    assertStreamPrint(NULL, 0 != heap->keys && 0 != heap->data, "out of memory");
+  }
+
+  i = heap->length++;
+  heap->keys[i].key = key;
+  heap->keys[i].seq = heap->seq++;
+  memcpy(heap->data + i*heap->itemSize, data, heap->itemSize);
+
+  /* sift up */
+  while(i > 0)
+  {
+    parent = (i-1)/2;
+    if(!heapLess(&heap->keys[i], &heap->keys[parent]))
+      break;
+    heapSwap(heap, i, parent);
+    i = parent;
+  }
+}
+
+void heapPop(HEAP *heap)
+{
+  unsigned int i = 0, child;
+  assertStreamPrint(NULL, 0 != heap, "invalid heap-pointer");
+  assertStreamPrint(NULL, 0 < heap->length, "empty heap");
+
+  heap->length--;
+  if(heap->length == 0)
+    return;
+
+  heap->keys[0] = heap->keys[heap->length];
+  memcpy(heap->data, heap->data + heap->length*heap->itemSize, heap->itemSize);
+
+  /* sift down */
+  while((child = 2*i+1) < heap->length)
+  {
+    if(child+1 < heap->length && heapLess(&heap->keys[child+1], &heap->keys[child]))
+      child++;
+    if(!heapLess(&heap->keys[child], &heap->keys[i]))
+      break;
+    heapSwap(heap, i, child);
+    i = child;
+  }
+}
+
+int heapLen(HEAP *heap)
+{
+  assertStreamPrint(NULL, 0 != heap, "invalid heap-pointer");
+  return heap->length;
+}
+
+void *heapTopData(HEAP *heap)
+{
+  assertStreamPrint(NULL, 0 != heap, "invalid heap-pointer");
+  assertStreamPrint(NULL, 0 < heap->length, "empty heap");
+  return heap->data;
+}
+
+double heapTopKey(HEAP *heap)
+{
+  assertStreamPrint(NULL, 0 != heap, "invalid heap-pointer");
+  assertStreamPrint(NULL, 0 < heap->length, "empty heap");
+  return heap->keys[0].key;
+}
+
+void heapClear(HEAP *heap)
+{
+  assertStreamPrint(NULL, 0 != heap, "invalid heap-pointer");
+  heap->length = 0;
+}
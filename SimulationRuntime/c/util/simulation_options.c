@@ -48,7 +48,9 @@ const char *FLAG_NAME[FLAG_MAX+1] = {
   /* FLAG_IDA_MAXCONVFAILS */      "idaMaxConvFails",
   /* FLAG_IDA_NONLINCONVCOEF */    "idaNonLinConvCoef",
   /* FLAG_IDA_LS */                "idaLS",
+  /* FLAG_IDA_PRECOND */           "idaPrecond",
   /* FLAG_IDAS */                  "idaSensitivity",
+  /* FLAG_IDAS_FILE */             "idaSensitivityFile",
   /* FLAG_IGNORE_HIDERESULT */     "ignoreHideResult",
   /* FLAG_IIF */                   "iif",
   /* FLAG_IIM */                   "iim",
@@ -79,6 +81,7 @@ const char *FLAG_NAME[FLAG_MAX+1] = {
   /* FLAG_MAX_STEP_SIZE */         "maxStepSize",
   /* FLAG_MEASURETIMEPLOTFORMAT */ "measureTimePlotFormat",
   /* FLAG_NEWTON_FTOL */           "newtonFTol",
+  /* FLAG_NEWTON_JACOBIAN_REUSE */ "newtonJacobianReuse",
   /* FLAG_NEWTON_XTOL */           "newtonXTol",
   /* FLAG_NEWTON_STRATEGY */       "newton",
   /* FLAG_NLS */                   "nls",
@@ -126,7 +129,9 @@ const char *FLAG_DESC[FLAG_MAX+1] = {
   /* FLAG_IDA_MAXCONVFAILS */      "value specifies the maximum number of nonlinear solver convergence failures at one step. The default value is 10.",
   /* FLAG_IDA_NONLINCONVCOEF */    "value specifies the safety factor in the nonlinear convergence test. The default value is 0.33.",
   /* FLAG_IDA_LS */                "selects the linear solver used by ida",
+  /* FLAG_IDA_PRECOND */           "selects the preconditioner of the iterative linear solvers used by ida",
   /* FLAG_IDAS */                  "flag to add sensitivity information to the result files",
+  /* FLAG_IDAS_FILE */             "value specifies a separate mat file for the sensitivity information",
   /* FLAG_IGNORE_HIDERESULT */     "ignore HideResult=true annotation",
   /* FLAG_IIF */                   "value specifies an external file for the initialization of the model",
   /* FLAG_IIM */                   "value specifies the initialization method",
@@ -157,6 +162,7 @@ const char *FLAG_DESC[FLAG_MAX+1] = {
   /* FLAG_MAX_STEP_SIZE */         "value specifies maximum absolute step size, used by dassl solver",
   /* FLAG_MEASURETIMEPLOTFORMAT */ "value specifies the output format of the measure time functionality",
   /* FLAG_NEWTON_FTOL */           "[double (default 1e-12)] tolerance respecting residuals for updating solution vector in Newton solver",
+  /* FLAG_NEWTON_JACOBIAN_REUSE */ "reuses the factorized Jacobian of the newton solver across calls and only updates it on slow convergence or after events",
   /* FLAG_NEWTON_XTOL */           "[double (default 1e-12)] tolerance respecting newton correction (delta_x) for updating solution vector in Newton solver",
   /* FLAG_NEWTON_STRATEGY */       "value specifies the damping strategy for the newton solver",
   /* FLAG_NLS */                   "value specifies the nonlinear solver",
@@ -231,8 +237,18 @@ const char *FLAG_DETAILED_DESC[FLAG_MAX+1] = {
   "  * spgmr - sparse iterative linear solver based on generalized minimal residual method, convergance is not guaranteed, sundials method\n"
   "  * spbcg - sparse iterative linear solver based on biconjugate gradient method, convergance is not guaranteed, sundials method\n"
   "  * spgmr - sparse iterative linear solver based on transpose free quasi-minimal residual method, convergance is not guaranteed, sundials method\n",
+  /* FLAG_IDA_PRECOND */
+  "  Value specifies the preconditioner of the iterative linear solvers (spgmr, spbcg, sptfqmr) of the IDA integrator.\n"
+  "  The preconditioner is built from the sparse pattern of the jacobian, so its memory is linear in the number of non-zeros. Valid values:\n\n"
+  "  * ilu - default, incomplete LU factorization without fill-in (ILU(0))\n"
+  "  * blockJacobi - LU factorization of the dense diagonal blocks of size 8\n"
+  "  * none - no preconditioner\n",
   /* FLAG_IDAS */
   "  Enables sensitivity analysis with respect to parameters if the model is compiled with omc flag --calculateSensitivities.",
+  /* FLAG_IDAS_FILE */
+  "  Value specifies a separate mat file for the sensitivity information of -idaSensitivity.\n"
+  "  The sensitivities are then stored there in single precision instead of in the result file, which keeps the result file small.\n"
+  "  Only used with the mat output format.",
   /* FLAG_IGNORE_HIDERESULT */
   "  Emits also variables with HideResult=true annotation.",
   /* FLAG_IIF */
@@ -314,6 +330,9 @@ const char *FLAG_DETAILED_DESC[FLAG_MAX+1] = {
   "  Tolerance respecting residuals for updating solution vector in Newton solver."
   "  Solution is accepted if the (scaled) 2-norm of the residuals is smaller than the tolerance newtonFTol and the (scaled) newton correction (delta_x) is smaller than the tolerance newtonXTol."
   "  The value is a Double with default value 1e-12.",
+  /* FLAG_NEWTON_JACOBIAN_REUSE */
+  "  Reuses the LU factorization of the Jacobian of the newton solver across calls (simplified Newton method).\n"
+  "  The Jacobian is only updated if the iteration converges too slowly, after events and during initialization.",
   /* FLAG_NEWTON_XTOL */
   "  Tolerance respecting newton correction (delta_x) for updating solution vector in Newton solver."
   "  Solution is accepted if the (scaled) 2-norm of the residuals is smaller than the tolerance newtonFTol and the (scaled) newton correction (delta_x) is smaller than the tolerance newtonXTol."
@@ -408,7 +427,9 @@ const int FLAG_TYPE[FLAG_MAX] = {
   /* FLAG_IDA_MAXCONVFAILS */      FLAG_TYPE_OPTION,
   /* FLAG_IDA_NONLINCONVCOEF */    FLAG_TYPE_OPTION,
   /* FLAG_IDA_LS */                FLAG_TYPE_OPTION,
+  /* FLAG_IDA_PRECOND */           FLAG_TYPE_OPTION,
   /* FLAG_IDAS */                  FLAG_TYPE_FLAG,
+  /* FLAG_IDAS_FILE */             FLAG_TYPE_OPTION,
   /* FLAG_IGNORE_HIDERESULT */     FLAG_TYPE_FLAG,
   /* FLAG_IIF */                   FLAG_TYPE_OPTION,
   /* FLAG_IIM */                   FLAG_TYPE_OPTION,
@@ -439,6 +460,7 @@ const int FLAG_TYPE[FLAG_MAX] = {
   /* FLAG_MAX_STEP_SIZE */         FLAG_TYPE_OPTION,
   /* FLAG_MEASURETIMEPLOTFORMAT */ FLAG_TYPE_OPTION,
   /* FLAG_NEWTON_FTOL */           FLAG_TYPE_OPTION,
+  /* FLAG_NEWTON_JACOBIAN_REUSE */ FLAG_TYPE_FLAG,
   /* FLAG_NEWTON_XTOL */           FLAG_TYPE_OPTION,
   /* FLAG_NEWTON_STRATEGY */       FLAG_TYPE_OPTION,
   /* FLAG_NLS */                   FLAG_TYPE_OPTION,
@@ -482,7 +504,8 @@ const char *SOLVER_METHOD_NAME[S_MAX] = {
   "symEulerSsc",
   "heun",
   "ida",
-  "qss"
+  "qss",
+  "multirate"
 };
 
 const char *SOLVER_METHOD_DESC[S_MAX] = {
@@ -501,7 +524,8 @@ const char *SOLVER_METHOD_DESC[S_MAX] = {
   "symEulerSsc - symbolic implicit euler with step-size control, [compiler flag +symEuler needed]",
   "heun - Heun's method (Runge-Kutta fixed step, order 2)",
   "ida - Sundials ida solver",
-  "qss - A QSS solver [experimental]"
+  "qss - A QSS solver [experimental]",
+  "multirate - Euler/Heun pair, sub-steps only the state partitions that miss the tolerance [compiler flag -d=multirate recommended, experimental]"
 };
 
 const char *INIT_METHOD_NAME[IIM_MAX] = {
@@ -675,4 +699,24 @@ const char *IDA_LS_METHOD_DESC[IDA_LS_MAX+1] = {
   "IDA_LS_MAX"
 };
 
+const char *IDA_PRECOND_METHOD[IDA_PRECOND_MAX+1] = {
+  "unknown",
+
+  "none",
+  "blockJacobi",
+  "ilu",
+
+  "IDA_PRECOND_MAX"
+};
+
+const char *IDA_PRECOND_METHOD_DESC[IDA_PRECOND_MAX+1] = {
+  "unknown",
+
+  "no preconditioner",
+  "block Jacobi preconditioner",
+  "incomplete LU factorization ILU(0)",
+
+  "IDA_PRECOND_MAX"
+};
+
 
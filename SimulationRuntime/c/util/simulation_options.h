@@ -56,7 +56,9 @@ enum _FLAG
   FLAG_IDA_MAXCONVFAILS,
   FLAG_IDA_NONLINCONVCOEF,
   FLAG_IDA_LS,
+  FLAG_IDA_PRECOND,
   FLAG_IDAS,
+  FLAG_IDAS_FILE,
   FLAG_IGNORE_HIDERESULT,
   FLAG_IIF,
   FLAG_IIM,
@@ -87,6 +89,7 @@ enum _FLAG
   FLAG_MAX_STEP_SIZE,
   FLAG_MEASURETIMEPLOTFORMAT,
   FLAG_NEWTON_FTOL,
+  FLAG_NEWTON_JACOBIAN_REUSE,
   FLAG_NEWTON_XTOL,
   FLAG_NEWTON_STRATEGY,
   FLAG_NLS,
@@ -150,6 +153,7 @@ enum SOLVER_METHOD
   S_HEUN,          /* 13 */
   S_IDA,           /* 14 */
   S_QSS,
+  S_MULTIRATE,
 
   S_MAX
 };
@@ -270,6 +274,20 @@ enum IDA_LS
 extern const char *IDA_LS_METHOD[IDA_LS_MAX+1];
 extern const char *IDA_LS_METHOD_DESC[IDA_LS_MAX+1];
 
+enum IDA_PRECOND
+{
+  IDA_PRECOND_UNKNOWN = 0,
+
+  IDA_PRECOND_NONE,
+  IDA_PRECOND_BLOCKJACOBI,
+  IDA_PRECOND_ILU,
+
+  IDA_PRECOND_MAX
+};
+
+extern const char *IDA_PRECOND_METHOD[IDA_PRECOND_MAX+1];
+extern const char *IDA_PRECOND_METHOD_DESC[IDA_PRECOND_MAX+1];
+
 
 
 
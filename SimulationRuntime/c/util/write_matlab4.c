@@ -55,25 +55,11 @@ int writeMatVer4AclassNormal(FILE *fout)
   return writeMatVer4Matrix(fout, "Aclass", 4, 11, Aclass_normal, sizeof(int8_t));
 }
 
-// writes MAT-file matrix header to file
-int writeMatVer4MatrixHeader(FILE *fout,const char *name, int rows, int cols, unsigned int size)
+static int writeMatVer4Header(FILE *fout, const char *name, int rows, int cols, int type)
 {
-  typedef struct MHeader {
-    uint32_t type;
-    uint32_t mrows;
-    uint32_t ncols;
-    uint32_t imagf;
-    uint32_t namelen;
-  } MHeader_t;
   const int endian_test = 1;
   MHeader_t hdr;
 
-  int type = 0;
-  if(size == 1 /* char */)
-    type = 51;
-  if(size == 4 /* int32 */)
-    type = 20;
-
   /* create matrix header structure */
   hdr.type = 1000*((*(char*)&endian_test) == 0) + type;
   hdr.mrows = rows;
@@ -85,6 +71,24 @@ int writeMatVer4MatrixHeader(FILE *fout,const char *name, int rows, int cols, un
   return !(1 == fwrite(&hdr, sizeof(MHeader_t), 1, fout) && 1 == fwrite(name, sizeof(char)*hdr.namelen, 1, fout));
 }
 
+// writes MAT-file matrix header to file
+int writeMatVer4MatrixHeader(FILE *fout,const char *name, int rows, int cols, unsigned int size)
+{
+  int type = 0;
+  if(size == 1 /* char */)
+    type = 51;
+  if(size == 4 /* int32 */)
+    type = 20;
+
+  return writeMatVer4Header(fout, name, rows, cols, type);
+}
+
+// writes MAT-file header of a single precision matrix to file
+int writeMatVer4FloatMatrixHeader(FILE *fout,const char *name, int rows, int cols)
+{
+  return writeMatVer4Header(fout, name, rows, cols, 10 /* float */);
+}
+
 int writeMatVer4Matrix(FILE *fout, const char *name, int rows, int cols, const void *matrixData, unsigned int size)
 {
   /* write data */
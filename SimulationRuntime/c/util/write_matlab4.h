@@ -38,6 +38,7 @@ extern "C" {
 /* Returns 0 on success */
 int writeMatVer4AclassNormal(FILE *fout);
 int writeMatVer4MatrixHeader(FILE *fout,const char *name, int rows, int cols, unsigned int size);
+int writeMatVer4FloatMatrixHeader(FILE *fout,const char *name, int rows, int cols);
 int writeMatVer4Matrix(FILE *fout, const char *name, int rows, int cols, const void *matrixData, unsigned int size);
 
 #ifdef __cplusplus
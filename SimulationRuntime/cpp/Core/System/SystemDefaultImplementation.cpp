@@ -12,9 +12,52 @@
 #include <Core/System/AlgLoopSolverFactory.h>
 
 
+template <class T>
+InitVars<T>::InitVars()
+  : _vars(NULL)
+{
+}
+
+template <class T>
+void InitVars<T>::setVarRange(T* vars, size_t size)
+{
+  if(vars == _vars && size == _table.size())
+    return;
+  _vars = vars;
+  _table.assign(size, StartValue());
+  if(!_vars)
+    return;
+  //move start values defined before the range was known into the table
+  typename unordered_map<T*, T>::iterator iter = _start_values.begin();
+  while(iter != _start_values.end())
+  {
+    if(iter->first >= _vars && iter->first < _vars + size)
+    {
+      StartValue& entry = _table[iter->first - _vars];
+      entry.value = iter->second;
+      entry.defined = true;
+      iter = _start_values.erase(iter);
+    }
+    else
+      ++iter;
+  }
+};
+
 template <class T>
 void InitVars<T>::setStartValue(T& variable,T val,bool overwriteOldValue)
 {
+  if(&variable >= _vars && &variable < _vars + _table.size())
+  {
+    StartValue& entry = _table[&variable - _vars];
+    if(!entry.defined || overwriteOldValue)
+    {
+      entry.value = val;
+      entry.defined = true;
+    }
+    else
+      LOGGER_WRITE("SystemDefaultImplementation: start value for variable is already defined",LC_INIT,LL_DEBUG);
+    return;
+  }
   //only add a start value if it was not already defined
   if(!_start_values.count(&variable) || overwriteOldValue)
     _start_values[&variable] = val;
@@ -25,6 +68,12 @@ void InitVars<T>::setStartValue(T& variable,T val,bool overwriteOldValue)
 template <class T>
 T& InitVars<T>::getGetStartValue(T& variable)
 {
+  if(&variable >= _vars && &variable < _vars + _table.size())
+  {
+    StartValue& entry = _table[&variable - _vars];
+    entry.defined = true;
+    return entry.value;
+  }
   return _start_values[&variable];
 };
 
@@ -195,6 +244,12 @@ void SystemDefaultImplementation::initialize()
 {
   _callType = IContinuous::CONTINUOUS;
 
+  shared_ptr<ISimVars> simVars = getSimVars();
+  _real_start_values.setVarRange(simVars->getRealVarsVector(), _dimReal);
+  _int_start_values.setVarRange(simVars->getIntVarsVector(), _dimInteger);
+  _bool_start_values.setVarRange(simVars->getBoolVarsVector(), _dimBoolean);
+  _string_start_values.setVarRange(simVars->getStringVarsVector(), _dimString);
+
   /*
   changed: is handled in SimVars class
   if((_dimContinuousStates) > 0)
@@ -30,6 +30,8 @@ public:
   virtual const matrix_t& getJacobian(unsigned int index)  = 0;
   virtual const sparsematrix_t& getSparseJacobian() = 0;
   virtual const sparsematrix_t& getSparseJacobian(unsigned int index)  = 0;
+  /// True if the Jacobians are provided by getSparseJacobian, false if by getJacobian
+  virtual bool isJacobianSparse() = 0;
 
   virtual const matrix_t& getStateSetJacobian(unsigned int index) = 0;
   virtual const sparsematrix_t& getStateSetSparseJacobian(unsigned int index) = 0;
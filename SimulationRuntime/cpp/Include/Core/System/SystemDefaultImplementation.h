@@ -28,14 +28,30 @@ Copyright (c) 2008, OSMC
 
 //typedef unordered_map<std::string, boost::any> SValuesMap;
 
+/**
+ * Start values of one variable type. Variables stored in the SimVars array
+ * registered with setVarRange are addressed by their index in a dense table,
+ * all other variables (e.g. class members) fall back to a map keyed by address.
+ */
 template <class T>
 class InitVars
 {
 public:
+  InitVars();
+  void setVarRange(T* vars, size_t size);
   void setStartValue(T& variable,T val,bool overwriteOldValue);
   T& getGetStartValue(T& variable);
 
 private:
+  struct StartValue
+  {
+    StartValue() : value(), defined(false) {}
+    T value;
+    bool defined;
+  };
+
+  T* _vars;                       ///< first element of the registered SimVars array
+  vector<StartValue> _table;      ///< start values indexed by position in _vars
   unordered_map<T*, T> _start_values;
 };
 
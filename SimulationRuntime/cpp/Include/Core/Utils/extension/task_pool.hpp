@@ -0,0 +1,395 @@
+/*
+ * task_pool.hpp
+ *
+ * Persistent thread pool that executes task graphs generated by hpcom.
+ * The worker threads are created once and sleep between two evaluations.
+ * Every worker owns a deque of ready tasks: new ready tasks are pushed to and popped from the back
+ * of the own deque, idle workers steal from the front of the other deques.
+ */
+
+#ifndef TASK_POOL_HPP_
+#define TASK_POOL_HPP_
+
+#ifdef USE_THREAD
+#include <Core/ModelicaDefine.h>
+#include <Core/Modelica.h>
+#include <Core/Utils/extension/measure_time.hpp>
+
+#if defined(__linux__)
+  #include <pthread.h>
+  #include <sched.h>
+#endif
+
+/**
+ * Static task graph. A task becomes ready when all of its parents are finished.
+ * The graph is built once (constructor of the system) and executed by TaskPool::run in every step.
+ */
+class TaskGraph
+{
+  friend class TaskPool;
+
+  public:
+    TaskGraph() : _pendingParents(NULL), _measurements(NULL) {}
+
+    ~TaskGraph()
+    {
+      if(_pendingParents)
+        delete [] _pendingParents;
+    }
+
+    /**
+     * Add a task to the graph and return its index. The edges are added after all tasks.
+     */
+    int addTask(function<void(void)> task)
+    {
+      _tasks.push_back(task);
+      _children.push_back(vector<int>());
+      _numParents.push_back(0);
+      return (int)_tasks.size() - 1;
+    }
+
+    void addEdge(int parentIdx, int childIdx)
+    {
+      _children[parentIdx].push_back(childIdx);
+      _numParents[childIdx]++;
+    }
+
+    /**
+     * Measure the execution time of every task. The vector needs one entry per task and is written
+     * as a result block of MeasureTime, so the task costs can be compared with the scheduler estimates.
+     */
+    void setMeasurements(std::vector<MeasureTimeData*> *measurements)
+    {
+      _measurements = measurements;
+    }
+
+    int size() const
+    {
+      return (int)_tasks.size();
+    }
+
+  private:
+    void prepare()
+    {
+      if(!_pendingParents)
+        _pendingParents = new atomic<int>[_tasks.size()];
+
+      for(unsigned i = 0; i < _tasks.size(); ++i)
+        _pendingParents[i].store(_numParents[i], memory_order_relaxed);
+    }
+
+    vector<function<void(void)> > _tasks;
+    vector<vector<int> > _children;
+    vector<int> _numParents;
+    atomic<int> *_pendingParents;
+    std::vector<MeasureTimeData*> *_measurements;
+};
+
+class TaskPool
+{
+  public:
+    TaskPool() : _numThreads(0), _graph(NULL), _remaining(0), _generation(0), _terminate(false), _failed(false) {}
+
+    ~TaskPool()
+    {
+      stop();
+    }
+
+    bool isRunning() const
+    {
+      return _numThreads > 0;
+    }
+
+    int getNumThreads() const
+    {
+      return _numThreads;
+    }
+
+    /**
+     * Create the worker threads. The calling thread takes part in the evaluation, so numThreads-1 workers are started.
+     * If pinThreads is set, the workers are bound to the cores 1..numThreads-1. This only pays off if the simulation
+     * has the machine for itself, so it is off by default.
+     */
+    void start(int numThreads, bool pinThreads = false)
+    {
+      stop();
+      _numThreads = numThreads < 1 ? 1 : numThreads;
+      _terminate = false;
+
+      for(int i = 0; i < _numThreads; ++i)
+      {
+        _queues.push_back(new WorkQueue());
+        _startValues.push_back(NULL);
+        _endValues.push_back(NULL);
+      }
+
+      for(int i = 1; i < _numThreads; ++i)
+      {
+        thread *worker = new thread(&TaskPool::workerLoop, this, i);
+        if(pinThreads)
+          pinThread(worker, i);
+        _workers.push_back(worker);
+      }
+    }
+
+    void stop()
+    {
+      if(_numThreads == 0)
+        return;
+
+      {
+        unique_lock<mutex> lock(_wakeMutex);
+        _terminate = true;
+        _generation++;
+      }
+      _wakeCondition.notify_all();
+
+      for(unsigned i = 0; i < _workers.size(); ++i)
+      {
+        _workers[i]->join();
+        delete _workers[i];
+      }
+      for(unsigned i = 0; i < _queues.size(); ++i)
+      {
+        delete _queues[i];
+        if(_startValues[i])
+          delete _startValues[i];
+        if(_endValues[i])
+          delete _endValues[i];
+      }
+      _workers.clear();
+      _queues.clear();
+      _startValues.clear();
+      _endValues.clear();
+      _numThreads = 0;
+    }
+
+    /**
+     * Execute all tasks of the graph and return when the last one is finished.
+     */
+    void run(TaskGraph &graph)
+    {
+      if(graph.size() == 0)
+        return;
+
+      if(_numThreads == 0)
+        start(1, false);
+
+      graph.prepare();
+      _graph = &graph;
+      _failed = false;
+      _remaining.store(graph.size());
+
+      int nextQueue = 0;
+      for(int i = 0; i < graph.size(); ++i)
+      {
+        if(graph._numParents[i] == 0)
+        {
+          _queues[nextQueue]->push(i);
+          nextQueue = (nextQueue + 1) % _numThreads;
+        }
+      }
+
+      if(_numThreads > 1)
+      {
+        {
+          unique_lock<mutex> lock(_wakeMutex);
+          _generation++;
+        }
+        _wakeCondition.notify_all();
+      }
+
+      processTasks(0);
+
+      if(_failed)
+        throw ModelicaSimulationError(MODEL_EQ_SYSTEM, "Task pool evaluation failed", _errorMessage);
+    }
+
+  private:
+    class WorkQueue
+    {
+      public:
+        WorkQueue() : _size(0) {}
+
+        void push(int taskIdx)
+        {
+          unique_lock<mutex> lock(_lock);
+          _tasks.push_back(taskIdx);
+          _size.store((int)_tasks.size());
+        }
+
+        //owner side
+        bool pop(int &taskIdx)
+        {
+          if(_size.load() == 0)
+            return false;
+          unique_lock<mutex> lock(_lock);
+          if(_tasks.empty())
+            return false;
+          taskIdx = _tasks.back();
+          _tasks.pop_back();
+          _size.store((int)_tasks.size());
+          return true;
+        }
+
+        //thief side
+        bool steal(int &taskIdx)
+        {
+          if(_size.load() == 0)
+            return false;
+          unique_lock<mutex> lock(_lock);
+          if(_tasks.empty())
+            return false;
+          taskIdx = _tasks.front();
+          _tasks.pop_front();
+          _size.store((int)_tasks.size());
+          return true;
+        }
+
+      private:
+        mutex _lock;
+        deque<int> _tasks;
+        atomic<int> _size; //lets idle workers look for tasks without taking the lock
+        char _padding[64]; //keep the queues of different workers in different cache lines
+    };
+
+    void workerLoop(int workerIdx)
+    {
+      unsigned int seenGeneration = 0;
+      while(true)
+      {
+        //spin a short time before sleeping, the next step usually starts immediately
+        int spin = 0;
+        while(_generation.load() == seenGeneration && spin < 10000)
+          spin++;
+
+        {
+          unique_lock<mutex> lock(_wakeMutex);
+          while(_generation.load() == seenGeneration)
+            _wakeCondition.wait(lock);
+          seenGeneration = _generation.load();
+          if(_terminate)
+            return;
+        }
+
+        processTasks(workerIdx);
+      }
+    }
+
+    void processTasks(int workerIdx)
+    {
+      int taskIdx;
+      int idlePasses = 0;
+      while(_remaining.load() > 0)
+      {
+        if(_queues[workerIdx]->pop(taskIdx) || stealTask(workerIdx, taskIdx))
+        {
+          executeTask(workerIdx, taskIdx);
+          idlePasses = 0;
+        }
+        //the running tasks usually release new ones soon, give up the core only if they take longer
+        else if(++idlePasses > 100)
+          yieldThread();
+      }
+    }
+
+    static void yieldThread()
+    {
+      #if defined(USE_CPP_03) || defined(__vxworks)
+      boost::this_thread::yield();
+      #else
+      std::this_thread::yield();
+      #endif
+    }
+
+    bool stealTask(int workerIdx, int &taskIdx)
+    {
+      for(int i = 1; i < _numThreads; ++i)
+      {
+        if(_queues[(workerIdx + i) % _numThreads]->steal(taskIdx))
+          return true;
+      }
+      return false;
+    }
+
+    void executeTask(int workerIdx, int taskIdx)
+    {
+      TaskGraph &graph = *_graph;
+      bool measure = graph._measurements != NULL && MeasureTime::getInstance() != NULL;
+
+      if(measure)
+      {
+        if(!_startValues[workerIdx])
+        {
+          _startValues[workerIdx] = MeasureTime::getZeroValues();
+          _endValues[workerIdx] = MeasureTime::getZeroValues();
+        }
+        MeasureTime::getTimeValuesStart(_startValues[workerIdx]);
+      }
+
+      try
+      {
+        graph._tasks[taskIdx]();
+      }
+      catch(std::exception &ex)
+      {
+        //the children are released anyway, otherwise the evaluation would never finish
+        unique_lock<mutex> lock(_wakeMutex);
+        if(!_failed)
+          _errorMessage = ex.what();
+        _failed = true;
+      }
+
+      if(measure)
+      {
+        MeasureTimeData *data = (*graph._measurements)[taskIdx];
+        MeasureTime::getTimeValuesEnd(_endValues[workerIdx]);
+        _endValues[workerIdx]->sub(_startValues[workerIdx]);
+        _endValues[workerIdx]->sub(MeasureTime::getOverhead());
+        data->_sumMeasuredValues->add(_endValues[workerIdx]);
+        ++(data->_sumMeasuredValues->_numCalcs);
+      }
+
+      const vector<int> &children = graph._children[taskIdx];
+      for(unsigned i = 0; i < children.size(); ++i)
+      {
+        if(graph._pendingParents[children[i]].fetch_sub(1) == 1)
+          _queues[workerIdx]->push(children[i]);
+      }
+
+      _remaining.fetch_sub(1);
+    }
+
+    static void pinThread(thread *worker, int core)
+    {
+      #if defined(__linux__)
+      unsigned int numCores = thread::hardware_concurrency();
+      if(numCores == 0)
+        return;
+
+      cpu_set_t cpuset;
+      CPU_ZERO(&cpuset);
+      CPU_SET(core % numCores, &cpuset);
+      pthread_setaffinity_np(worker->native_handle(), sizeof(cpu_set_t), &cpuset);
+      #endif
+    }
+
+    int _numThreads;
+    vector<thread*> _workers;
+    vector<WorkQueue*> _queues;
+    vector<MeasureTimeValues*> _startValues;
+    vector<MeasureTimeValues*> _endValues;
+
+    TaskGraph *_graph;
+    atomic<int> _remaining;
+    atomic<unsigned int> _generation;
+    mutex _wakeMutex;
+    condition_variable _wakeCondition;
+    bool _terminate;
+    volatile bool _failed;
+    string _errorMessage;
+};
+
+#endif //USE_THREAD
+
+#endif /* TASK_POOL_HPP_ */
@@ -132,10 +132,7 @@ private:
     *_z,            ///< Output      - (Current) State vector
     *_zInit,          ///< Temp      - Initial state vector
     *_zWrite,                   ///< Temp      - Zustand den das System rausschreibt
-    *_absTol,          ///         - Vektor für absolute Toleranzen
-  *_delta,
-  *_deltaInv,
-  *_ysave;
+    *_absTol;          ///         - Vektor für absolute Toleranzen
 
 
   double
@@ -167,10 +164,7 @@ double
   // Variables for Coloured Jacobians
   int* _colorOfColumn;
   int  _maxColors;
-  matrix_t _jacobianA;
-  int _jacobianANonzeros;
-  int const* _jacobianAIndex;
-  int const* _jacobianALeadindex;
+  bool _sparseJacobian;             ///< Temp      - System provides its jacobian in the sparse matrix format
 
 
 
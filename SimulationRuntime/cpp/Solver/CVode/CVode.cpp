@@ -35,12 +35,7 @@ Cvode::Cvode(IMixedSystem* system, ISolverSettings* settings)
       _mixed_system(NULL),
       _time_system(NULL),
       _numberOfOdeEvaluations(0),
-      _delta(NULL),
-      _deltaInv(NULL),
-      _ysave(NULL),
       _colorOfColumn (NULL),
-      _jacobianAIndex(NULL),
-      _jacobianALeadindex(NULL),
       _CV_absTol(),
       _tLastWrite(-1.0),
       _bWritten(false),
@@ -49,7 +44,7 @@ Cvode::Cvode(IMixedSystem* system, ISolverSettings* settings)
       _CV_y(),
       _CV_yWrite(),
       _maxColors(0),
-      _jacobianANonzeros(0)
+      _sparseJacobian(false)
 {
   _data = ((void*) this);
 
@@ -110,12 +105,6 @@ Cvode::~Cvode()
 
   if (_colorOfColumn)
     delete [] _colorOfColumn;
-  if(_delta)
-    delete [] _delta;
-    if(_deltaInv)
-    delete [] _deltaInv;
-  if(_ysave)
-    delete [] _ysave;
 
   #ifdef RUNTIME_PROFILING
   if(measuredFunctionStartValues)
@@ -166,25 +155,15 @@ void Cvode::initialize()
       delete[] _zeroSign;
     if (_absTol)
       delete[] _absTol;
-  if(_delta)
-    delete [] _delta;
-    if(_deltaInv)
-    delete [] _deltaInv;
-    if(_ysave)
-    delete [] _ysave;
 
     _z = new double[_dimSys];
     _zInit = new double[_dimSys];
     _zWrite = new double[_dimSys];
     _zeroSign = new int[_dimZeroFunc];
     _absTol = new double[_dimSys];
-  _delta =new double[_dimSys];
-    _deltaInv =new double[_dimSys];
-  _ysave =new double[_dimSys];
 
     memset(_z, 0, _dimSys * sizeof(double));
     memset(_zInit, 0, _dimSys * sizeof(double));
-  memset(_ysave, 0, _dimSys * sizeof(double));
 
     // Counter initialisieren
     _outStps = 0;
@@ -293,14 +272,15 @@ void Cvode::initialize()
       throw ModelicaSimulationError(SOLVER,"Cvode::initialize()");
 
   // Use own jacobian matrix
-  // Check if Colored Jacobians are worth to use
+  // A symbolic jacobian is generated if the system provides a coloring of its columns
    #if SUNDIALS_MAJOR_VERSION >= 2 || (SUNDIALS_MAJOR_VERSION == 2 && SUNDIALS_MINOR_VERSION >= 4)
     _maxColors = _system->getAMaxColors();
-    if(_maxColors < _dimSys && _continuous_system->getDimContinuousStates() > 0)
+    if(_maxColors > 0 && _continuous_system->getDimContinuousStates() > 0)
     {
-   // _idid = CVDlsSetDenseJacFn(_cvodeMem, &CV_JCallback);
-   // initializeColoredJac();
-  }
+      initializeColoredJac();
+      _idid = CVDlsSetDenseJacFn(_cvodeMem, &CV_JCallback);
+      LOGGER_WRITE("Cvode: using symbolic jacobian with " + to_string(_maxColors) + " colors for " + to_string(_dimSys) + " states", LC_SOLV, LL_INFO);
+    }
   #endif
 
   if (_idid < 0)
@@ -787,141 +767,48 @@ int Cvode::calcJacobian(double t, long int N, N_Vector fHelp, N_Vector errorWeig
 {
   try
   {
-  int l,g;
-  double fnorm, minInc, *f_data, *fHelp_data, *errorWeight_data, h, srur, delta_inv;
-
-  f_data = NV_DATA_S(fy);
-  errorWeight_data = NV_DATA_S(errorWeight);
-  fHelp_data = NV_DATA_S(fHelp);
-
+    // Update the system at the current states, the jacobian columns are evaluated at this point
+    if(calcFunction(t, y, NV_DATA_S(fHelp)) != 0)
+      return 1;
 
-  //Get relevant info
-  _idid = CVodeGetErrWeights(_cvodeMem, errorWeight);
-  if (_idid < 0)
-    {
-      _idid = -5;
-      throw ModelicaSimulationError(SOLVER,"Cvode::calcJacobian()");
-  }
-  _idid = CVodeGetCurrentStep(_cvodeMem, &h);
-  if (_idid < 0)
+    if(_sparseJacobian)
     {
-      _idid = -5;
-      throw ModelicaSimulationError(SOLVER,"Cvode::calcJacobian()");
-  }
-
-  srur = sqrt(UROUND);
-
-  fnorm = N_VWrmsNorm(fy, errorWeight);
-  minInc = (fnorm != 0.0) ?
-           (1000.0 * abs(h) * UROUND * N * fnorm) : 1.0;
-
-  for(int j=0;j<N;j++)
-  {
-    _delta[j] = max(srur*abs(y[j]), minInc/errorWeight_data[j]);
-  }
-
-  for(int j=0;j<N;j++)
-  {
-    _deltaInv[j] = 1/_delta[j];
-  }
-
- if (_jacobianANonzeros != 0)
- {
-  for(int color=1; color <= _maxColors; color++)
-  {
-      for(int k=0; k < _dimSys; k++)
-    {
-      if((_colorOfColumn[k] ) == color)
-      {
-        _ysave[k] = y[k];
-        y[k]+= _delta[k];
-      }
+      const sparsematrix_t& A = _system->getSparseJacobian();
+      SetToZero(Jac);
+      for(sparsematrix_t::const_iterator1 it1 = A.begin1(); it1 != A.end1(); ++it1)
+        for(sparsematrix_t::const_iterator2 it2 = it1.begin(); it2 != it1.end(); ++it2)
+          DENSE_ELEM(Jac, it2.index1(), it2.index2()) = *it2;
     }
-
-    calcFunction(t, y, fHelp_data);
-
-  for (int k = 0; k < _dimSys; k++)
-   {
-       if((_colorOfColumn[k]) == color)
-     {
-        y[k] = _ysave[k];
-
-    int startOfColumn = k * _dimSys;
-    for (int j = _jacobianALeadindex[k]; j < _jacobianALeadindex[k+1];j++)
+    else
+    {
+      const matrix_t& A = _system->getJacobian();
+      for(long int j = 0; j < N; j++)
       {
-        l = _jacobianAIndex[j];
-        g = l + startOfColumn;
-        Jac->data[g] = (fHelp_data[l] - f_data[l]) * _deltaInv[k];
+        double* col = DENSE_COL(Jac, j);
+        for(long int i = 0; i < N; i++)
+          col[i] = A(i, j);
       }
     }
   }
-  }
- }
-
-
-
-
-
-  }
-
-
-
-
-
-
-  /*
-  //Calculation of J without colouring
-   for (j = 0; j < N; j++)
-   {
-
-
-    //N_VSetArrayPointer(DENSE_COL(Jac,j), jthCol);
-
-     _ysave[j] = y[j];
-
-    y[j] += _delta[j];
-
-    calcFunction(t, y, fHelp_data);
-
-    y[j] = _ysave[j];
-
-    delta_inv = 1.0/_delta[j];
-    N_VLinearSum(delta_inv, fHelp, -delta_inv, fy, jthCol);
-
-    for(int i=0; i<_dimSys; ++i)
-        {
-            Jac->data[i+j*_dimSys] = NV_Ith_S(jthCol,i);
-        }
-
-    //DENSE_COL(Jac,j) = N_VGetArrayPointer(jthCol);
-  }
-  */
-
-    //workaround until exception can be catch from c- libraries
+  //workaround until exception can be catch from c- libraries
   catch (std::exception & ex )
   {
-
     cerr << "CVode integration error: " <<  ex.what();
     return 1;
   }
 
-
   return 0;
 }
 
 void Cvode::initializeColoredJac()
 {
-
   if(_colorOfColumn)
-	  delete [] _colorOfColumn;
+    delete [] _colorOfColumn;
   _colorOfColumn = new int[_dimSys];
   _system->getAColorOfColumn( _colorOfColumn, _dimSys);
 
- // _system->getJacobian(_jacobianA);
-  //_jacobianANonzeros  = boost::numeric::bindings::traits::spmatrix_num_nonzeros (_jacobianA);
- // _jacobianAIndex     = bindings::begin_index_minor(_jacobianA);
-  //_jacobianALeadindex = bindings::begin_index_major(_jacobianA);
-
+  // The generated system implements only the accessor for the configured matrix format
+  _sparseJacobian = _system->isJacobianSparse();
 }
 
 int Cvode::reportErrorMessage(ostream& messageStream)
@@ -969,6 +856,14 @@ void Cvode::writeSimulationInfo()
   LOGGER_WRITE("Cvode: convergence failures 'ncfn' = " + to_string(ncfn), LC_SOLV, LL_INFO);
   LOGGER_WRITE("Cvode: number of evaluateODE calls 'eODE' = " + to_string(_numberOfOdeEvaluations), LC_SOLV, LL_INFO);
 
+  long int nje, nfeLS;
+  flag = CVDlsGetNumJacEvals(_cvodeMem, &nje);
+  flag = CVDlsGetNumRhsEvals(_cvodeMem, &nfeLS);
+  LOGGER_WRITE("Cvode: jacobian evaluations 'nje' = " + to_string(nje), LC_SOLV, LL_INFO);
+  LOGGER_WRITE("Cvode: function evaluations for finite difference jacobians 'nfeLS' = " + to_string(nfeLS), LC_SOLV, LL_INFO);
+  if (_maxColors > 0 && nfeLS == 0)
+    LOGGER_WRITE("Cvode: function evaluations saved by symbolic jacobian = " + to_string(nje * _dimSys), LC_SOLV, LL_INFO);
+
   //// Solver
   //outputStream  << "\nSolver: " << getName()
   //  << "\nVerfahren: ";
@@ -33,9 +33,25 @@
 #include "omc_opc_ua.h"
 #include "open62541.h"
 #include <pthread.h>
+#include <time.h>
 
 #define BAD_RESULT() fprintf(stderr, "%s:%d: Bad OPC result\n", __FILE__, __LINE__);
 
+/* Values published by the simulation thread after each step. Three snapshots
+ * are used as a triple buffer: the simulation thread fills its own buffer and
+ * swaps it with the latest one, the server thread swaps the latest one with
+ * the buffer it reads from. Neither side ever waits for the other.
+ * There must only be one reading thread (the server thread).
+ */
+typedef struct {
+  double time;
+  UA_Double *realVals;
+  UA_Boolean *boolVals;
+} omc_opc_ua_snapshot;
+
+#define SNAPSHOT_INDEX 3
+#define SNAPSHOT_FRESH 4
+
 typedef struct {
   DATA *data;
   UA_Logger logger;
@@ -46,15 +62,16 @@ typedef struct {
   UA_Boolean step;
   pthread_mutex_t mutex_pause;
   pthread_cond_t cond_pause;
-  double time;
   pthread_t thread;
   UA_MethodAttributes runAttr;
-  pthread_rwlock_t rwlock;
+  omc_opc_ua_snapshot snapshot[3];
+  int writeIndex; /* only used by the simulation thread */
+  int readIndex; /* only used by the server thread */
+  int latestIndex; /* index of the latest snapshot, | SNAPSHOT_FRESH if not read yet; accessed atomically */
+  pthread_mutex_t mutex_input; /* protects the new inputs and states; the simulation thread only tries to lock it */
   double *inputVarsBackup;
   int gotNewInput;
-  UA_Double *realVals; /* All nReal doubles backed up in a separate array protected by rwlock */
   int *realValsInputIndex;
-  UA_Boolean *boolVals; /* All nReal doubles backed up in a separate array protected by rwlock */
   int *boolValsInputIndex;
   int reinitStateFlag;
   int *stateWasUpdatedFlag;
@@ -85,6 +102,37 @@ static void* threadWork(void *data)
   return status == UA_STATUSCODE_GOOD ? (void*)0 : (void*)1;
 }
 
+/* Called by the server thread; returns the most recently published values */
+static omc_opc_ua_snapshot* readSnapshot(omc_opc_ua_state *state)
+{
+  if (__atomic_load_n(&state->latestIndex, __ATOMIC_ACQUIRE) & SNAPSHOT_FRESH) {
+    state->readIndex = __atomic_exchange_n(&state->latestIndex, state->readIndex, __ATOMIC_ACQ_REL) & SNAPSHOT_INDEX;
+  }
+  return &state->snapshot[state->readIndex];
+}
+
+static void fillSnapshot(omc_opc_ua_state *state, omc_opc_ua_snapshot *snapshot, double t)
+{
+  DATA *data = state->data;
+  MODEL_DATA *modelData = data->modelData;
+  int i;
+
+  snapshot->time = t;
+  for (i = 0; i < modelData->nVariablesReal; i++) {
+    snapshot->realVals[i] = (data->localData[0])->realVars[i];
+  }
+  for (i = 0; i < modelData->nVariablesBoolean; i++) {
+    snapshot->boolVals[i] = (data->localData[0])->booleanVars[i];
+  }
+}
+
+/* Called by the simulation thread; fills the free snapshot and publishes it */
+static void writeSnapshot(omc_opc_ua_state *state, double t)
+{
+  fillSnapshot(state, &state->snapshot[state->writeIndex], t);
+  state->writeIndex = __atomic_exchange_n(&state->latestIndex, state->writeIndex | SNAPSHOT_FRESH, __ATOMIC_ACQ_REL) & SNAPSHOT_INDEX;
+}
+
 static void waitForStep(omc_opc_ua_state *state)
 {
   int run;
@@ -124,10 +172,8 @@ readBoolean(void *handle, const UA_NodeId nodeid, UA_Boolean sourceTimeStamp, co
     int index1 = nodeid.identifier.numeric-VARKIND_BOOL*MAX_VARS_KIND;
     int index = index1 >= ALIAS_START_ID ? modelData->booleanAlias[index1-ALIAS_START_ID].nameID : index1;
     int negate = index1 >= ALIAS_START_ID ? modelData->booleanAlias[index1-ALIAS_START_ID].negate : 0;
-    pthread_rwlock_rdlock(&state->rwlock);
-    val = state->boolVals[index];
+    val = readSnapshot(state)->boolVals[index];
     val = negate ? !val : val;
-    pthread_rwlock_unlock(&state->rwlock);
   } else {
     dataValue->hasValue = UA_FALSE;
     BAD_RESULT()
@@ -165,10 +211,12 @@ writeBoolean(void *handle, const UA_NodeId nodeid, const UA_Variant *data, const
       int inputIndex = state->boolValsInputIndex[index];
       newVal = negate ? !newVal : newVal;
       if (inputIndex != -1) {
-        if (state->data->simulationInfo->inputVars[inputIndex] != newVal) {
-          state->gotNewInput = 1;
+        pthread_mutex_lock(&state->mutex_input);
+        if (state->inputVarsBackup[inputIndex] != newVal) {
           state->inputVarsBackup[inputIndex] = newVal;
+          __atomic_store_n(&state->gotNewInput, 1, __ATOMIC_RELEASE);
         }
+        pthread_mutex_unlock(&state->mutex_input);
       } else {
         statusCode = UA_STATUSCODE_BADUNEXPECTEDERROR;
       }
@@ -196,21 +244,15 @@ readReal(void *handle, const UA_NodeId nodeid, UA_Boolean sourceTimeStamp, const
   }
 
   if (nodeid.identifier.numeric==OMC_OPC_NODEID_TIME) {
-    pthread_rwlock_rdlock(&state->rwlock);
-    val = state->time;
-    pthread_rwlock_unlock(&state->rwlock);
+    val = readSnapshot(state)->time;
   } else if (nodeid.identifier.numeric==OMC_OPC_NODEID_REAL_TIME_SCALING_FACTOR) {
-    pthread_rwlock_rdlock(&state->rwlock);
     val = state->real_time_sync_scaling;
-    pthread_rwlock_unlock(&state->rwlock);
   } else if (nodeid.identifier.numeric >= VARKIND_REAL*MAX_VARS_KIND && nodeid.identifier.numeric < (1+VARKIND_REAL)*MAX_VARS_KIND) {
     int index1 = nodeid.identifier.numeric-VARKIND_REAL*MAX_VARS_KIND;
     int index = index1 >= ALIAS_START_ID ? modelData->realAlias[index1-ALIAS_START_ID].nameID : index1;
     int negate = index1 >= ALIAS_START_ID ? modelData->realAlias[index1-ALIAS_START_ID].negate : 0;
-    pthread_rwlock_rdlock(&state->rwlock);
-    val = state->realVals[index];
+    val = readSnapshot(state)->realVals[index];
     val = negate ? -val : val;
-    pthread_rwlock_unlock(&state->rwlock);
   } else {
     BAD_RESULT()
     return UA_STATUSCODE_BADNODEIDUNKNOWN;
@@ -250,14 +292,18 @@ writeReal(void *handle, const UA_NodeId nodeid, const UA_Variant *data, const UA
     int inputIndex = state->realValsInputIndex[index];
     newVal = negate ? -newVal : newVal;
     if (inputIndex != -1) {
-      if (state->data->simulationInfo->inputVars[inputIndex] != newVal) {
-        state->gotNewInput = 1;
+      pthread_mutex_lock(&state->mutex_input);
+      if (state->inputVarsBackup[inputIndex] != newVal) {
         state->inputVarsBackup[inputIndex] = newVal;
+        __atomic_store_n(&state->gotNewInput, 1, __ATOMIC_RELEASE);
       }
+      pthread_mutex_unlock(&state->mutex_input);
     } else if (index < state->data->modelData->nStates) {
-      state->reinitStateFlag = 1;
+      pthread_mutex_lock(&state->mutex_input);
       state->stateWasUpdatedFlag[index] = 1;
       state->updatedStates[index] = newVal;
+      __atomic_store_n(&state->reinitStateFlag, 1, __ATOMIC_RELEASE);
+      pthread_mutex_unlock(&state->mutex_input);
     } else {
       BAD_RESULT()
       return UA_STATUSCODE_BADUNEXPECTEDERROR;
@@ -289,7 +335,6 @@ static inline omc_opc_ua_state* addVars(omc_opc_ua_state *state, var_kind_t varK
     case VARKIND_REAL:
     {
       STATIC_REAL_DATA *realVarsData = modelData->realVarsData;
-      state->realVals[*varIndex] = ((double*)vars)[i];
       inputIndex = realVarsData[i].info.inputIndex;
       state->realValsInputIndex[*varIndex] = inputIndex;
       nameStr = (char*) realVarsData[i].info.name;
@@ -301,7 +346,6 @@ static inline omc_opc_ua_state* addVars(omc_opc_ua_state *state, var_kind_t varK
     case VARKIND_BOOL:
     {
       STATIC_BOOLEAN_DATA *booleanVarsData = modelData->booleanVarsData;
-      state->boolVals[*varIndex] = ((int*)vars)[i];
       inputIndex = booleanVarsData[i].info.inputIndex;
       state->boolValsInputIndex[*varIndex] = inputIndex;
       nameStr = (char*) booleanVarsData[i].info.name;
@@ -454,6 +498,7 @@ void* omc_embedded_server_init(DATA *data, double t, double step, const char *ar
   omc_opc_ua_state *state = (omc_opc_ua_state*) malloc(sizeof(omc_opc_ua_state));
   UA_ServerConfig config = UA_ServerConfig_standard;
   var_kind_t vk;
+  int i;
   state->logger = Logger_Stdout;
   state->nl = UA_ServerNetworkLayerTCP(UA_ConnectionConfig_standard, 4841);
   config.logger = Logger_Stdout;
@@ -464,12 +509,11 @@ void* omc_embedded_server_init(DATA *data, double t, double step, const char *ar
   state->real_time_sync_scaling = data->real_time_sync.scaling;
 
   state->server_running = 1;
-  state->time = t;
   state->omc_real_time_sync_update = omc_real_time_sync_update;
 
   pthread_cond_init(&state->cond_pause, NULL);
   pthread_mutex_init(&state->mutex_pause, NULL);
-  pthread_rwlock_init(&state->rwlock, NULL);
+  pthread_mutex_init(&state->mutex_input, NULL);
   state->run = 0;
   state->step = 0;
 
@@ -487,6 +531,28 @@ void* omc_embedded_server_init(DATA *data, double t, double step, const char *ar
                           0, NULL, 0, NULL, NULL);
 */
 
+  state->gotNewInput = 0;
+  state->inputVarsBackup = malloc(modelData->nInputVars * sizeof(double));
+  memcpy(state->inputVarsBackup, data->simulationInfo->inputVars, modelData->nInputVars * sizeof(double));
+  state->realValsInputIndex = malloc(modelData->nVariablesReal * sizeof(int));
+  state->boolValsInputIndex = malloc(modelData->nVariablesBoolean * sizeof(int));
+  for (i = 0; i < 3; i++) {
+    state->snapshot[i].realVals = malloc(modelData->nVariablesReal * sizeof(UA_Double));
+    state->snapshot[i].boolVals = malloc(modelData->nVariablesBoolean * sizeof(UA_Boolean));
+  }
+
+  state->reinitStateFlag = 0;
+  state->stateWasUpdatedFlag = (int*) calloc(sizeof(int), modelData->nStates);
+  state->updatedStates = (double*) malloc(sizeof(double)*modelData->nStates);
+
+  /* all snapshots hold the initial values before the server thread starts */
+  for (i = 0; i < 3; i++) {
+    fillSnapshot(state, &state->snapshot[i], t);
+  }
+  state->latestIndex = 0;
+  state->readIndex = 1;
+  state->writeIndex = 2;
+
   pthread_create(&state->thread, NULL, (void*) &threadWork, state);
 
   /* add a variable node to the address space */
@@ -559,20 +625,6 @@ void* omc_embedded_server_init(DATA *data, double t, double step, const char *ar
                                       UA_NODEID_NUMERIC(0, UA_NS0ID_ORGANIZES),
                                       timeName, UA_NODEID_NULL, timeAttr, timeDataSource, NULL);
 
-  pthread_rwlock_wrlock(&state->rwlock);
-
-  state->gotNewInput = 0;
-  state->inputVarsBackup = malloc(modelData->nInputVars * sizeof(double));
-  memcpy(state->inputVarsBackup, data->simulationInfo->inputVars, modelData->nInputVars * sizeof(double));
-  state->realVals = malloc(modelData->nVariablesReal * sizeof(UA_Double));
-  state->realValsInputIndex = malloc(modelData->nVariablesReal * sizeof(int));
-  state->boolVals = malloc(modelData->nVariablesBoolean * sizeof(UA_Boolean));
-  state->boolValsInputIndex = malloc(modelData->nVariablesBoolean * sizeof(int));
-
-  state->reinitStateFlag = 0;
-  state->stateWasUpdatedFlag = (int*) calloc(sizeof(int), modelData->nStates);
-  state->updatedStates = (double*) malloc(sizeof(double)*modelData->nStates);
-
   int realIndex = 0, boolIndex = 0;
   assert(modelData->nVariablesReal < MAX_VARS_KIND);
 
@@ -583,8 +635,6 @@ void* omc_embedded_server_init(DATA *data, double t, double step, const char *ar
     state = addAliasVars(state, vk);
   }
 
-  pthread_rwlock_unlock(&state->rwlock);
-
   if (state) {
     fprintf(stderr, "omc_embedded_server_init done, state=%p, server=%p. Pause run=%d step=%d\n", state, state->server, state->run, state->step);
     waitForStep(state);
@@ -597,6 +647,7 @@ void omc_embedded_server_deinit(void *state_vp)
 {
   omc_opc_ua_state *state = (omc_opc_ua_state*) state_vp;
   void *res;
+  int i;
 
   state->server_running = 0;
   if (pthread_join(state->thread, &res)) {
@@ -607,50 +658,64 @@ void omc_embedded_server_deinit(void *state_vp)
   }
   UA_Server_delete(state->server);
   state->nl.deleteMembers(&state->nl);
-  pthread_rwlock_destroy(&state->rwlock);
+  pthread_mutex_destroy(&state->mutex_input);
   pthread_mutex_destroy(&state->mutex_pause);
   pthread_cond_destroy(&state->cond_pause);
   free(state->inputVarsBackup);
-  free(state->realVals);
   free(state->realValsInputIndex);
-  free(state->boolVals);
   free(state->boolValsInputIndex);
+  free(state->stateWasUpdatedFlag);
+  free(state->updatedStates);
+  for (i = 0; i < 3; i++) {
+    free(state->snapshot[i].realVals);
+    free(state->snapshot[i].boolVals);
+  }
   free(state);
 }
 
 void omc_embedded_server_update(void *state_vp, double t)
 {
   omc_opc_ua_state *state = (omc_opc_ua_state*) state_vp;
-  int i, realIndex=0, boolIndex=0;
+  int i;
   DATA *data = state->data;
   MODEL_DATA *modelData = data->modelData;
-
-  pthread_rwlock_wrlock(&state->rwlock);
-
-  state->time = t;
-
-  for (i = 0; i < modelData->nVariablesReal; i++, realIndex++) {
-    state->realVals[realIndex] = (data->localData[0])->realVars[i];
-  }
-  for (i = 0; i < modelData->nVariablesReal; i++, boolIndex++) {
-    state->boolVals[boolIndex] = (data->localData[0])->booleanVars[i];
-  }
-
-  if (state->gotNewInput) {
-    memcpy(data->simulationInfo->inputVars, state->inputVarsBackup, modelData->nInputVars * sizeof(double));
-  }
-
-  if (state->reinitStateFlag) {
-    // TODO: Trigger an event / restarting the numerical solver
-    for (i = 0; i < modelData->nStates; i++) {
-      if (state->stateWasUpdatedFlag[i]) {
-        state->stateWasUpdatedFlag[i] = 0;
-        (data->localData[0])->realVars[i] = state->updatedStates[i];
+  struct timespec start, end;
+  int64_t nano;
+
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  writeSnapshot(state, t);
+
+  /* Apply the inputs received since the last step all at once. If the
+   * server thread is just writing new values, they are applied after the
+   * next step instead of blocking the simulation. */
+  if ((__atomic_load_n(&state->gotNewInput, __ATOMIC_ACQUIRE) || __atomic_load_n(&state->reinitStateFlag, __ATOMIC_ACQUIRE))
+      && 0 == pthread_mutex_trylock(&state->mutex_input)) {
+    if (state->gotNewInput) {
+      state->gotNewInput = 0;
+      memcpy(data->simulationInfo->inputVars, state->inputVarsBackup, modelData->nInputVars * sizeof(double));
+    }
+    if (state->reinitStateFlag) {
+      // TODO: Trigger an event / restarting the numerical solver
+      state->reinitStateFlag = 0;
+      for (i = 0; i < modelData->nStates; i++) {
+        if (state->stateWasUpdatedFlag[i]) {
+          state->stateWasUpdatedFlag[i] = 0;
+          (data->localData[0])->realVars[i] = state->updatedStates[i];
+        }
       }
     }
+    pthread_mutex_unlock(&state->mutex_input);
   }
 
-  pthread_rwlock_unlock(&state->rwlock);
+  /* the statistics only cover publishing and applying inputs; a pause
+   * requested by a client is not part of the latency */
+  clock_gettime(CLOCK_MONOTONIC, &end);
+  nano = (int64_t) (end.tv_sec - start.tv_sec) * 1000000000 + (end.tv_nsec - start.tv_nsec);
+  data->real_time_sync.totalServerUpdate += nano;
+  data->real_time_sync.nServerUpdates++;
+  if (nano > data->real_time_sync.maxServerUpdate) {
+    data->real_time_sync.maxServerUpdate = nano;
+  }
 
   waitForStep(state);
 }